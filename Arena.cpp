@@ -0,0 +1,40 @@
+#include "Arena.hpp"
+
+#include <new>
+
+void arena_init(Arena* arena, size_t size)
+{
+	arena->data = size ? static_cast<uint8_t*>(operator new[](size, std::align_val_t(ARENA_ALIGN))) : nullptr;
+	arena->size = size;
+	arena->used = 0;
+	arena->owned = true;
+}
+
+void arena_init_sub(Arena* arena, Arena* parent, size_t size)
+{
+	arena->data = static_cast<uint8_t*>(arena_alloc(parent, size));
+	arena->size = arena_size(size);
+	arena->used = 0;
+	arena->owned = false;
+}
+
+void arena_free(Arena* arena)
+{
+	if (arena->owned && arena->data) operator delete[](arena->data, std::align_val_t(ARENA_ALIGN));
+	*arena = {};
+}
+
+void arena_reset(Arena* arena)
+{
+	arena->used = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size)
+{
+	size_t bytes = arena_size(size);
+	if (bytes > arena->size - arena->used) throw std::bad_alloc();
+
+	void* data = arena->data + arena->used;
+	arena->used += bytes;
+	return data;
+}
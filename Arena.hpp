@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Linear allocator over one block. Allocations bump an offset and are never
+// freed one by one: a whole scope goes at once when its arena is reset or
+// freed. A sub-arena is a slice of its parent, so nested scopes (a game, one
+// of its ticks) share the parent's block and the parent releases them all.
+// Running out of room throws std::bad_alloc, like new.
+
+// Every allocation starts on this boundary, so the room a set of arrays
+// needs can be added up ahead of time with arena_size()
+const size_t ARENA_ALIGN = 16;
+
+struct Arena
+{
+	uint8_t* data;
+	size_t size;
+	size_t used;
+	bool owned;   // data came from arena_init() rather than a parent
+};
+
+// Bytes an allocation of size takes from an arena
+constexpr size_t arena_size(size_t size)
+{
+	return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+template<typename T>
+constexpr size_t arena_size(size_t count)
+{
+	return arena_size(count * sizeof(T));
+}
+
+void arena_init(Arena* arena, size_t size);
+
+// Takes size bytes from parent. The sub-arena is gone when the parent is
+// reset or freed and needs no arena_free() of its own.
+void arena_init_sub(Arena* arena, Arena* parent, size_t size);
+
+void arena_free(Arena* arena);
+
+// Frees everything allocated from arena
+void arena_reset(Arena* arena);
+
+void* arena_alloc(Arena* arena, size_t size);
+
+// Uninitialized array of count elements
+template<typename T>
+T* arena_push(Arena* arena, size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+		"arena memory is never constructed or destroyed");
+	static_assert(alignof(T) <= ARENA_ALIGN);
+	return static_cast<T*>(arena_alloc(arena, count * sizeof(T)));
+}
@@ -0,0 +1,136 @@
+#include "Atlas.hpp"
+
+#include "File.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+static const char ATLAS_MAGIC[4] = { 'S', 'I', 'A', 'T' };
+
+// The layout must not depend on the compiler's padding rules
+static_assert(sizeof(AtlasHeader) == 24 && sizeof(AtlasEntry) == 24);
+
+// Atlas sprites in id order, with the number of frames each holds
+static void atlas_sprites(const Sprites& sprites, const Sprite** out, size_t* num_frames)
+{
+	for (size_t i = 0; i < ALIEN_SPRITES_MAX; i++)
+	{
+		out[ATLAS_ALIEN_FIRST + i] = &sprites.aliens[i];
+		num_frames[ATLAS_ALIEN_FIRST + i] = 1;
+	}
+	out[ATLAS_ALIEN_DEATH] = &sprites.alien_death;
+	out[ATLAS_PLAYER] = &sprites.player;
+	out[ATLAS_BULLET] = &sprites.bullet;
+	out[ATLAS_GLYPHS] = &sprites.text;
+	num_frames[ATLAS_ALIEN_DEATH] = 1;
+	num_frames[ATLAS_PLAYER] = 1;
+	num_frames[ATLAS_BULLET] = 1;
+	num_frames[ATLAS_GLYPHS] = GLYPH_COUNT;
+}
+
+static size_t align8(size_t size)
+{
+	return (size + 7) & ~static_cast<size_t>(7);
+}
+
+size_t atlas_size(const Sprites& sprites)
+{
+	const Sprite* list[ATLAS_SPRITE_COUNT];
+	size_t num_frames[ATLAS_SPRITE_COUNT];
+	atlas_sprites(sprites, list, num_frames);
+
+	size_t size = sizeof(AtlasHeader) + ATLAS_SPRITE_COUNT * sizeof(AtlasEntry);
+	for (size_t i = 0; i < ATLAS_SPRITE_COUNT; i++)
+	{
+		size += align8(list[i]->width * list[i]->height * num_frames[i]);
+	}
+	return size;
+}
+
+void atlas_write(const Sprites& sprites, uint8_t* data)
+{
+	const Sprite* list[ATLAS_SPRITE_COUNT];
+	size_t num_frames[ATLAS_SPRITE_COUNT];
+	atlas_sprites(sprites, list, num_frames);
+
+	size_t size = atlas_size(sprites);
+	memset(data, 0, size);
+
+	AtlasHeader* header = reinterpret_cast<AtlasHeader*>(data);
+	memcpy(header->magic, ATLAS_MAGIC, sizeof(ATLAS_MAGIC));
+	header->version = ATLAS_VERSION;
+	header->size = size;
+	header->num_sprites = ATLAS_SPRITE_COUNT;
+
+	AtlasEntry* entries = reinterpret_cast<AtlasEntry*>(data + sizeof(AtlasHeader));
+	size_t offset = sizeof(AtlasHeader) + ATLAS_SPRITE_COUNT * sizeof(AtlasEntry);
+	for (size_t i = 0; i < ATLAS_SPRITE_COUNT; i++)
+	{
+		const Sprite& sprite = *list[i];
+		size_t bytes = sprite.width * sprite.height * num_frames[i];
+		entries[i] = {
+			static_cast<uint32_t>(i),
+			static_cast<uint32_t>(sprite.width), static_cast<uint32_t>(sprite.height),
+			static_cast<uint32_t>(num_frames[i]), offset
+		};
+		memcpy(data + offset, sprite.data, bytes);
+		offset += align8(bytes);
+	}
+}
+
+bool atlas_save(const Sprites& sprites, const char* path)
+{
+	size_t size = atlas_size(sprites);
+	uint8_t* data = new uint8_t[size];
+	atlas_write(sprites, data);
+
+	bool ok = file_write(path, data, size);
+
+	delete[] data;
+
+	if (!ok) fprintf(stderr, "Failed to write sprite atlas %s\n", path);
+	return ok;
+}
+
+bool atlas_load(Sprites* sprites, const uint8_t* data, size_t size)
+{
+	if (size < sizeof(AtlasHeader)) return false;
+
+	const AtlasHeader* header = reinterpret_cast<const AtlasHeader*>(data);
+	if (memcmp(header->magic, ATLAS_MAGIC, sizeof(ATLAS_MAGIC)) != 0 || header->version != ATLAS_VERSION) return false;
+	if (header->size != size || header->num_sprites > (size - sizeof(AtlasHeader)) / sizeof(AtlasEntry)) return false;
+
+	// Ids unknown to this build are skipped, every known one is required
+	Sprite found[ATLAS_SPRITE_COUNT] = {};
+	const AtlasEntry* entries = reinterpret_cast<const AtlasEntry*>(data + sizeof(AtlasHeader));
+	for (size_t i = 0; i < header->num_sprites; i++)
+	{
+		const AtlasEntry& entry = entries[i];
+		if (entry.id >= ATLAS_SPRITE_COUNT) continue;
+
+		uint64_t bytes = uint64_t(entry.width) * entry.height * entry.num_frames;
+		if (!bytes || entry.offset > size || bytes > size - entry.offset) return false;
+
+		uint32_t expected_frames = entry.id == ATLAS_GLYPHS ? static_cast<uint32_t>(GLYPH_COUNT) : 1;
+		if (entry.num_frames != expected_frames || found[entry.id].data) return false;
+
+		found[entry.id] = { entry.width, entry.height, data + entry.offset };
+	}
+
+	for (size_t i = 0; i < ATLAS_SPRITE_COUNT; i++)
+	{
+		if (!found[i].data) return false;
+	}
+
+	for (size_t i = 0; i < ALIEN_SPRITES_MAX; i++)
+	{
+		sprites->aliens[i] = found[ATLAS_ALIEN_FIRST + i];
+	}
+	sprites->alien_death = found[ATLAS_ALIEN_DEATH];
+	sprites->player = found[ATLAS_PLAYER];
+	sprites->bullet = found[ATLAS_BULLET];
+	sprites->text = found[ATLAS_GLYPHS];
+	sprites->numbers = sprites->text;
+	sprites->numbers.data += GLYPH_DIGITS * sprites->text.width * sprites->text.height;
+	return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Sprites.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Binary sprite atlas: an AtlasHeader, a directory of one AtlasEntry per
+// sprite, then the pixels of every sprite, one byte per pixel with frames
+// stacked top to bottom. The file is mapped read-only and the loaded
+// sprites point straight into the mapping, so loading takes the same time
+// for any amount of art and every process running the game shares the
+// same physical pages. Integers are stored little-endian.
+
+const uint32_t ATLAS_VERSION = 1;
+
+enum AtlasSpriteId : uint32_t
+{
+	ATLAS_ALIEN_FIRST,                                            // ALIEN_SPRITES_MAX in Sprites::aliens order
+	ATLAS_ALIEN_DEATH = ATLAS_ALIEN_FIRST + ALIEN_SPRITES_MAX,
+	ATLAS_PLAYER,
+	ATLAS_BULLET,
+	ATLAS_GLYPHS,                                                 // GLYPH_COUNT frames
+	ATLAS_SPRITE_COUNT,
+};
+
+struct AtlasHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t size;
+	uint32_t num_sprites;
+	uint32_t reserved;
+};
+
+struct AtlasEntry
+{
+	uint32_t id;
+	uint32_t width, height;   // Of one frame
+	uint32_t num_frames;
+	uint64_t offset;          // From the start of the file
+};
+
+size_t atlas_size(const Sprites& sprites);
+void atlas_write(const Sprites& sprites, uint8_t* data);
+bool atlas_save(const Sprites& sprites, const char* path);
+
+// Points sprites into the atlas in data, which has to stay mapped for as
+// long as they are used. Returns false, leaving sprites alone, if data is
+// not a valid atlas holding every sprite.
+bool atlas_load(Sprites* sprites, const uint8_t* data, size_t size);
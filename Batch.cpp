@@ -0,0 +1,138 @@
+#include "Batch.hpp"
+#include "Buffer.hpp"
+
+#include <cassert>
+
+// Games per job. Steps are cheap, so a few games per job keep the
+// scheduling overhead down.
+static const size_t BATCH_GRAIN = 8;
+
+GameInput action_input(uint8_t action)
+{
+	GameInput input = { 0, false };
+	switch (action)
+	{
+	case ACTION_LEFT: input.move_dir = -1; break;
+	case ACTION_RIGHT: input.move_dir = 1; break;
+	case ACTION_FIRE: input.fire = true; break;
+	case ACTION_LEFT_FIRE: input.move_dir = -1; input.fire = true; break;
+	case ACTION_RIGHT_FIRE: input.move_dir = 1; input.fire = true; break;
+	default: break;
+	}
+	return input;
+}
+
+void batch_init(
+	BatchEnv* env, size_t num_games, const GameConfig& config, const Sprites* sprites,
+	JobSystem* jobs, uint64_t max_episode_ticks
+)
+{
+	env->num_games = num_games;
+	env->games = new Game[num_games];
+	env->episodes = new uint64_t[num_games];
+	env->max_episode_ticks = max_episode_ticks;
+	env->jobs = jobs;
+
+	arena_init(&env->memory, num_games * arena_size(game_memory_size(config, sprites, BUFFER_WIDTH, BUFFER_HEIGHT)));
+	for (size_t i = 0; i < num_games; i++)
+	{
+		game_init(&env->games[i], config, sprites, BUFFER_WIDTH, BUFFER_HEIGHT, &env->memory);
+		env->episodes[i] = 0;
+	}
+
+	env->observer = nullptr;
+	env->num_frames = 0;
+	env->frames = nullptr;
+}
+
+void batch_free(BatchEnv* env)
+{
+	arena_free(&env->memory);
+	delete[] env->games;
+	delete[] env->episodes;
+	delete[] env->frames;
+	*env = {};
+}
+
+void batch_set_observer(BatchEnv* env, const Observer* observer)
+{
+	delete[] env->frames;
+	env->observer = observer;
+	env->num_frames = env->jobs ? env->jobs->num_workers : 1;
+	env->frames = new uint32_t[env->num_frames * BUFFER_WIDTH * BUFFER_HEIGHT];
+}
+
+static void batch_reset_game(BatchEnv* env, size_t i)
+{
+	Game* game = &env->games[i];
+	game_reset(game);
+
+	// Every episode of every game gets its own stream
+	uint64_t episode = env->episodes[i]++;
+	random_seed(&game->random, game->config.seed, episode * env->num_games + i);
+}
+
+static void batch_observe(BatchEnv* env, size_t i, uint32_t* observations, uint8_t* pooled)
+{
+	Game* game = &env->games[i];
+	size_t frame_size = game->width * game->height;
+	assert(!pooled || env->observer);
+
+	uint32_t* frame;
+	if (observations)
+	{
+		frame = observations + i * frame_size;
+	}
+	else
+	{
+		// Render into the worker's own scratch frame. Only the workers of
+		// env->jobs have one.
+		assert(jobs_worker_index() < env->num_frames);
+		frame = env->frames + jobs_worker_index() * frame_size;
+	}
+	Buffer buffer = { game->width, game->height, frame };
+	buffer_draw_game(&buffer, *game, rgb_to_uint32(0, 128, 0));
+
+	if (pooled)
+	{
+		const Observer* observer = env->observer;
+		observe_buffer(observer, buffer, pooled + i * observer->width * observer->height);
+	}
+}
+
+void batch_reset(BatchEnv* env, uint32_t* observations, uint8_t* pooled)
+{
+	jobs_parallel_for(env->jobs, env->num_games, BATCH_GRAIN, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			batch_reset_game(env, i);
+			if (observations || pooled) batch_observe(env, i, observations, pooled);
+		}
+	});
+}
+
+void batch_step(
+	BatchEnv* env, const uint8_t* actions,
+	int32_t* rewards, uint8_t* dones, uint32_t* observations, uint8_t* pooled
+)
+{
+	jobs_parallel_for(env->jobs, env->num_games, BATCH_GRAIN, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			Game* game = &env->games[i];
+			uint64_t score = game->score;
+			uint32_t wave = game->wave;
+			game_simulate(game, action_input(actions[i]));
+
+			bool done = game->wave != wave ||
+				(env->max_episode_ticks && game->tick >= env->max_episode_ticks);
+
+			if (rewards) rewards[i] = static_cast<int32_t>(game->score - score);
+			if (dones) dones[i] = done;
+			if (done) batch_reset_game(env, i);
+			if (observations || pooled) batch_observe(env, i, observations, pooled);
+		}
+	});
+}
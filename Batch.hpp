@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Game.hpp"
+#include "Jobs.hpp"
+#include "Observation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// N independent games stepped in lockstep for agent training. Games are
+// kept in one array and stepped in parallel on the job system. A game
+// that finishes is reset in place with game_reset(), with a fresh random
+// stream for the new episode.
+
+enum Action : uint8_t
+{
+	ACTION_NONE,
+	ACTION_LEFT,
+	ACTION_RIGHT,
+	ACTION_FIRE,
+	ACTION_LEFT_FIRE,
+	ACTION_RIGHT_FIRE,
+	ACTION_COUNT
+};
+
+struct BatchEnv
+{
+	size_t num_games;
+	Game* games;
+	Arena memory;             // Of every game, back to back
+	uint64_t* episodes;       // Episodes started per game
+	uint64_t max_episode_ticks;
+
+	JobSystem* jobs;
+
+	// Optional downsampling of the observations, with one frame per worker
+	// to render into when the full frames are not wanted
+	const Observer* observer;
+	size_t num_frames;
+	uint32_t* frames;
+};
+
+GameInput action_input(uint8_t action);
+
+// Creates num_games games with config. Episodes end when the first wave
+// is cleared or after max_episode_ticks ticks, 0 for no limit. jobs may be
+// null.
+void batch_init(
+	BatchEnv* env, size_t num_games, const GameConfig& config, const Sprites* sprites,
+	JobSystem* jobs, uint64_t max_episode_ticks
+);
+void batch_free(BatchEnv* env);
+
+// Enables the pooled outputs of batch_reset() and batch_step(). observer
+// must be set up for BUFFER_WIDTH x BUFFER_HEIGHT sources and outlive env.
+void batch_set_observer(BatchEnv* env, const Observer* observer);
+
+// Starts a new episode in every game. observations, if not null, receives
+// num_games frames of BUFFER_WIDTH * BUFFER_HEIGHT pixels as drawn by
+// buffer_draw_game(). pooled, if not null, receives num_games grayscale
+// images from the observer, so it needs batch_set_observer() first.
+void batch_reset(BatchEnv* env, uint32_t* observations, uint8_t* pooled);
+
+// Advances every game by one tick with actions[i]. rewards[i] is the
+// score gained, dones[i] is set when game i finished this step; it has
+// then already been reset and its observation shows the new episode.
+// Any of the outputs may be null.
+void batch_step(
+	BatchEnv* env, const uint8_t* actions,
+	int32_t* rewards, uint8_t* dones, uint32_t* observations, uint8_t* pooled
+);
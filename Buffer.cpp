@@ -0,0 +1,173 @@
+#include "Buffer.hpp"
+
+#include <bit>
+
+uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b)
+{
+	return (r << 24) | (g << 16) | (b << 8) | 255;
+}
+
+void buffer_clear(Buffer* buffer, uint32_t color)
+{
+	for (size_t i = 0; i < buffer->width * buffer->height; i++)
+	{
+		buffer->data[i] = color;
+	}
+}
+
+void buffer_draw_sprite(
+	Buffer* buffer, const Sprite& sprite, size_t x, size_t y, uint32_t color
+)
+{
+	for (size_t xi = 0; xi < sprite.width; xi++)
+	{
+		for (size_t yi = 0; yi < sprite.height; yi++)
+		{
+			size_t sy = sprite.height - 1 + y - yi;
+			size_t sx = x + xi;
+			if (sprite.data[yi * sprite.width + xi] && sy < buffer->height && sx < buffer->width)
+			{
+				buffer->data[sy * buffer->width + sx] = color;
+			}
+		}
+	}
+}
+
+void buffer_draw_text(
+	Buffer* buffer,
+	const Sprite& text_spritesheet,
+	const char* text,
+	size_t x, size_t y,
+	uint32_t color)
+{
+	size_t xp = x;
+	size_t stride = text_spritesheet.width * text_spritesheet.height;
+	Sprite sprite = text_spritesheet;
+	for (const char* charp = text; *charp != '\0'; ++charp)
+	{
+		char character = *charp - 32;
+		if (character < 0 || character >= 65) continue;
+
+		sprite.data = text_spritesheet.data + character * stride;
+		buffer_draw_sprite(buffer, sprite, xp, y, color);
+		xp += sprite.width + 1;
+	}
+}
+
+void buffer_draw_number(
+	Buffer* buffer,
+	const Sprite& number_spritesheet,
+	size_t number,
+	size_t x, size_t y,
+	uint32_t color
+)
+{
+	uint8_t digits[64];
+	size_t num_digits = 0;
+
+	size_t current_number = number;
+	do
+	{
+		digits[num_digits++] = current_number % 10;
+		current_number = current_number / 10;
+	} while (current_number > 0);
+
+	size_t xp = x;
+	size_t stride = number_spritesheet.width * number_spritesheet.height;
+	Sprite sprite = number_spritesheet;
+	for (size_t i = 0; i < num_digits; ++i)
+	{
+		uint8_t digit = digits[num_digits - i - 1];
+		sprite.data = number_spritesheet.data + digit * stride;
+		buffer_draw_sprite(buffer, sprite, xp, y, color);
+		xp += sprite.width + 1;
+	}
+}
+
+void buffer_draw_shields(Buffer* buffer, const Shield* shields, uint32_t color)
+{
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		const Shield& shield = shields[i];
+		for (int32_t r = 0; r < SHIELD_HEIGHT; r++)
+		{
+			size_t y = static_cast<size_t>(shield.y + r);
+			if (y >= buffer->height) continue;
+
+			uint32_t* line = buffer->data + y * buffer->width;
+			for (uint32_t bits = shield.rows[r]; bits; bits &= bits - 1)
+			{
+				size_t x = static_cast<size_t>(shield.x + SHIELD_WIDTH - 1 - std::countr_zero(bits));
+				if (x < buffer->width) line[x] = color;
+			}
+		}
+	}
+}
+
+void buffer_draw_hud(Buffer* buffer, const Sprites& sprites, size_t width, size_t height, uint64_t score)
+{
+	// SCORE
+	buffer_draw_text(buffer, sprites.text, "SCORE",
+		4, height - sprites.text.height - 7,
+		rgb_to_uint32(128, 0, 0)
+	);
+
+	buffer_draw_number(buffer, sprites.numbers, static_cast<size_t>(score),
+		4 + 2 * sprites.numbers.width, height - 2 * sprites.numbers.height - 12,
+		rgb_to_uint32(128, 0, 0)
+	);
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		buffer->data[width * 16 + i] = rgb_to_uint32(128, 0, 0);
+	}
+
+	buffer_draw_text(
+		buffer,
+		sprites.text, "CREDIT 00",
+		164, 7,
+		rgb_to_uint32(128, 0, 0)
+	);
+}
+
+void buffer_draw_game(Buffer* buffer, Game& game, uint32_t clear_color)
+{
+	const Sprites& sprites = *game.sprites;
+
+	buffer_clear(buffer, clear_color);
+
+	// Draw
+	buffer_draw_hud(buffer, sprites, game.width, game.height, game.score);
+
+	size_t cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, ALIEN_COMPONENTS, &cursor))
+	{
+		const Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		const Alien* aliens = ecs_column<Alien>(archetype, COMPONENT_ALIEN);
+		for (size_t ai = 0; ai < archetype->count; ai++)
+		{
+			const Sprite& sprite = aliens[ai].type == ALIEN_DEAD ?
+				sprites.alien_death : game_alien_sprite(game, aliens[ai].type);
+			buffer_draw_sprite(buffer, sprite,
+				fixed_to_int(positions[ai].x), fixed_to_int(positions[ai].y), rgb_to_uint32(128, 0, 0));
+		}
+	}
+
+	buffer_draw_shields(buffer, game.shields, rgb_to_uint32(128, 0, 0));
+
+	// Draw bullet
+	cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, BULLET_COMPONENTS, &cursor))
+	{
+		const Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		for (size_t bi = 0; bi < archetype->count; bi++)
+		{
+			buffer_draw_sprite(buffer, sprites.bullet,
+				fixed_to_int(positions[bi].x), fixed_to_int(positions[bi].y), rgb_to_uint32(128, 0, 0));
+		}
+	}
+
+	const Position& player = *ecs_get<Position>(&game.world, game.player, COMPONENT_POSITION);
+	buffer_draw_sprite(buffer, sprites.player,
+		fixed_to_int(player.x), fixed_to_int(player.y), rgb_to_uint32(128, 0, 0));
+}
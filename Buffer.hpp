@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Software rendering of the game into an RGBA framebuffer
+
+const size_t BUFFER_WIDTH = 224;
+const size_t BUFFER_HEIGHT = 256;
+
+struct Buffer
+{
+	size_t width, height;
+	uint32_t* data;
+};
+
+uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b);
+
+void buffer_clear(Buffer* buffer, uint32_t color);
+void buffer_draw_sprite(Buffer* buffer, const Sprite& sprite, size_t x, size_t y, uint32_t color);
+void buffer_draw_text(Buffer* buffer, const Sprite& text_spritesheet, const char* text, size_t x, size_t y, uint32_t color);
+void buffer_draw_number(Buffer* buffer, const Sprite& number_spritesheet, size_t number, size_t x, size_t y, uint32_t color);
+
+// Score, the line under it and the credit counter for a game width by height
+void buffer_draw_hud(Buffer* buffer, const Sprites& sprites, size_t width, size_t height, uint64_t score);
+
+// Expands the set bits of every shield row straight into pixels
+void buffer_draw_shields(Buffer* buffer, const Shield* shields, uint32_t color);
+
+// Draws the whole frame: score, aliens, bullets and player
+void buffer_draw_game(Buffer* buffer, Game& game, uint32_t clear_color);
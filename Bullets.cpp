@@ -0,0 +1,165 @@
+#include "Bullets.hpp"
+
+#include <bit>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BULLETS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BULLETS_TARGET_AVX2
+#else
+#define BULLETS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+static size_t bullets_integrate_scalar(
+	Position* positions, const Velocity* velocities, size_t begin, size_t count,
+	Fixed y_min, Fixed y_max, uint8_t* alive_mask
+)
+{
+	size_t num_alive = 0;
+	for (size_t i = begin; i < count; i++)
+	{
+		positions[i].x = fixed_add(positions[i].x, velocities[i].x);
+		positions[i].y = fixed_add(positions[i].y, velocities[i].y);
+
+		bool alive = positions[i].y >= y_min && positions[i].y < y_max;
+		if (i % 8 == 0) alive_mask[i / 8] = 0;
+		alive_mask[i / 8] |= static_cast<uint8_t>(alive) << (i % 8);
+		num_alive += alive;
+	}
+
+	return num_alive;
+}
+
+#ifdef BULLETS_X86
+
+// Positions and velocities are interleaved (x, y) pairs, so a plain vector
+// add integrates both axes at once. The y lanes are then gathered in bullet
+// order for the bounds test.
+
+static size_t bullets_integrate_sse2(
+	Position* positions, const Velocity* velocities, size_t count,
+	Fixed y_min, Fixed y_max, uint8_t* alive_mask
+)
+{
+	const __m128i lo = _mm_set1_epi32(y_min - 1);
+	const __m128i hi = _mm_set1_epi32(y_max);
+	int32_t* p = &positions[0].x;
+	const int32_t* v = &velocities[0].x;
+
+	size_t num_alive = 0;
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		int bits = 0;
+		for (size_t half = 0; half < 2; half++)
+		{
+			size_t k = 2 * (i + 4 * half);
+			__m128i a = _mm_add_epi32(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + k)));
+			__m128i b = _mm_add_epi32(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k + 4)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + k + 4)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p + k), a);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p + k + 4), b);
+
+			__m128i y = _mm_castps_si128(_mm_shuffle_ps(
+				_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+			__m128i alive = _mm_and_si128(_mm_cmpgt_epi32(y, lo), _mm_cmplt_epi32(y, hi));
+			bits |= _mm_movemask_ps(_mm_castsi128_ps(alive)) << (4 * half);
+		}
+
+		alive_mask[i / 8] = static_cast<uint8_t>(bits);
+		num_alive += std::popcount(static_cast<unsigned>(bits));
+	}
+
+	return num_alive + bullets_integrate_scalar(positions, velocities, i, count, y_min, y_max, alive_mask);
+}
+
+BULLETS_TARGET_AVX2
+static size_t bullets_integrate_avx2(
+	Position* positions, const Velocity* velocities, size_t count,
+	Fixed y_min, Fixed y_max, uint8_t* alive_mask
+)
+{
+	const __m256i lo = _mm256_set1_epi32(y_min - 1);
+	const __m256i hi = _mm256_set1_epi32(y_max);
+	int32_t* p = &positions[0].x;
+	const int32_t* v = &velocities[0].x;
+
+	size_t num_alive = 0;
+	size_t i = 0;
+	// 16 bullets per iteration, two mask bytes
+	for (; i + 16 <= count; i += 16)
+	{
+		unsigned bits = 0;
+		for (size_t half = 0; half < 2; half++)
+		{
+			size_t k = 2 * (i + 8 * half);
+			__m256i a = _mm256_add_epi32(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + k)));
+			__m256i b = _mm256_add_epi32(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k + 8)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + k + 8)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(p + k), a);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(p + k + 8), b);
+
+			// Lanes come out as bullets 0,1,4,5 | 2,3,6,7, fix up the 64-bit pairs
+			__m256i y = _mm256_castps_si256(_mm256_shuffle_ps(
+				_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+			y = _mm256_permute4x64_epi64(y, _MM_SHUFFLE(3, 1, 2, 0));
+			__m256i alive = _mm256_and_si256(_mm256_cmpgt_epi32(y, lo), _mm256_cmpgt_epi32(hi, y));
+			bits |= static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(alive))) << (8 * half);
+		}
+
+		alive_mask[i / 8] = static_cast<uint8_t>(bits);
+		alive_mask[i / 8 + 1] = static_cast<uint8_t>(bits >> 8);
+		num_alive += std::popcount(bits);
+	}
+
+	return num_alive + bullets_integrate_sse2(
+		positions + i, velocities + i, count - i, y_min, y_max, alive_mask + i / 8);
+}
+
+static bool cpu_has_avx2()
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// AVX2 needs OSXSAVE and the OS saving the YMM state
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+	if ((_xgetbv(0) & 6) != 6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const bool has_avx2 = cpu_has_avx2();
+
+#endif
+
+size_t bullets_integrate(
+	Position* positions, const Velocity* velocities, size_t count,
+	Fixed y_min, Fixed y_max, uint8_t* alive_mask
+)
+{
+#ifdef BULLETS_X86
+	if (has_avx2)
+	{
+		return bullets_integrate_avx2(positions, velocities, count, y_min, y_max, alive_mask);
+	}
+	return bullets_integrate_sse2(positions, velocities, count, y_min, y_max, alive_mask);
+#else
+	return bullets_integrate_scalar(positions, velocities, 0, count, y_min, y_max, alive_mask);
+#endif
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Components.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Number of bytes needed for an alive mask covering count bullets
+constexpr size_t bullets_mask_size(size_t count)
+{
+	return (count + 7) / 8;
+}
+
+// Moves every bullet by its velocity and writes one bit per bullet into
+// alive_mask (bit i % 8 of byte i / 8), set when y_min <= y < y_max.
+// Positions wrap on overflow, the same on every code path.
+// Returns the number of bullets still alive.
+size_t bullets_integrate(
+	Position* positions, const Velocity* velocities, size_t count,
+	Fixed y_min, Fixed y_max, uint8_t* alive_mask
+);
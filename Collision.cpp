@@ -0,0 +1,132 @@
+#include "Collision.hpp"
+
+#include <cstring>
+
+static size_t cell_index(int32_t coordinate, size_t cells)
+{
+	if (coordinate < 0) return 0;
+
+	size_t cell = static_cast<size_t>(coordinate / COLLISION_CELL_SIZE);
+	return cell < cells ? cell : cells - 1;
+}
+
+static bool box_overlap(const CollisionBox& a, const CollisionBox& b)
+{
+	return a.x < b.x + b.width && a.x + a.width > b.x &&
+		a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+static size_t grid_cells(size_t size)
+{
+	return (size + COLLISION_CELL_SIZE - 1) / COLLISION_CELL_SIZE;
+}
+
+size_t collision_grid_memory_size(size_t width, size_t height)
+{
+	return arena_size<uint32_t>(grid_cells(width) * grid_cells(height) + 1);
+}
+
+void collision_grid_init(CollisionGrid* grid, size_t width, size_t height, Arena* arena)
+{
+	grid->columns = grid_cells(width);
+	grid->rows = grid_cells(height);
+	grid->cell_start = arena_push<uint32_t>(arena, grid->columns * grid->rows + 1);
+	grid->entries = nullptr;
+}
+
+size_t collision_box_max_cells(size_t width, size_t height)
+{
+	// Worst case starts on the last pixel of a cell
+	size_t columns = (width + COLLISION_CELL_SIZE - 2) / COLLISION_CELL_SIZE + 1;
+	size_t rows = (height + COLLISION_CELL_SIZE - 2) / COLLISION_CELL_SIZE + 1;
+	return columns * rows;
+}
+
+void collision_grid_build(CollisionGrid* grid, const CollisionBox* boxes, size_t count, Arena* scratch)
+{
+	size_t num_cells = grid->columns * grid->rows;
+
+	// Counting sort: count entries per cell, prefix sum, then fill in box
+	// order so every cell ends up sorted
+	uint32_t* start = grid->cell_start;
+	memset(start, 0, (num_cells + 1) * sizeof(uint32_t));
+	for (size_t i = 0; i < count; i++)
+	{
+		const CollisionBox& box = boxes[i];
+		size_t x0 = cell_index(box.x, grid->columns);
+		size_t x1 = cell_index(box.x + box.width - 1, grid->columns);
+		size_t y0 = cell_index(box.y, grid->rows);
+		size_t y1 = cell_index(box.y + box.height - 1, grid->rows);
+		for (size_t cy = y0; cy <= y1; cy++)
+		{
+			for (size_t cx = x0; cx <= x1; cx++)
+			{
+				++start[cy * grid->columns + cx + 1];
+			}
+		}
+	}
+
+	for (size_t c = 0; c < num_cells; c++)
+	{
+		start[c + 1] += start[c];
+	}
+
+	grid->entries = arena_push<uint32_t>(scratch, start[num_cells]);
+
+	// Fill using the starts as cursors, then shift them back into place
+	for (size_t i = 0; i < count; i++)
+	{
+		const CollisionBox& box = boxes[i];
+		size_t x0 = cell_index(box.x, grid->columns);
+		size_t x1 = cell_index(box.x + box.width - 1, grid->columns);
+		size_t y0 = cell_index(box.y, grid->rows);
+		size_t y1 = cell_index(box.y + box.height - 1, grid->rows);
+		for (size_t cy = y0; cy <= y1; cy++)
+		{
+			for (size_t cx = x0; cx <= x1; cx++)
+			{
+				grid->entries[start[cy * grid->columns + cx]++] = static_cast<uint32_t>(i);
+			}
+		}
+	}
+
+	for (size_t c = num_cells; c > 0; c--)
+	{
+		start[c] = start[c - 1];
+	}
+	start[0] = 0;
+}
+
+uint32_t collision_grid_first_hit(
+	const CollisionGrid* grid, const CollisionBox* boxes, const uint8_t* alive,
+	const CollisionBox& box
+)
+{
+	size_t x0 = cell_index(box.x, grid->columns);
+	size_t x1 = cell_index(box.x + box.width - 1, grid->columns);
+	size_t y0 = cell_index(box.y, grid->rows);
+	size_t y1 = cell_index(box.y + box.height - 1, grid->rows);
+
+	uint32_t first = COLLISION_NONE;
+	for (size_t cy = y0; cy <= y1; cy++)
+	{
+		for (size_t cx = x0; cx <= x1; cx++)
+		{
+			size_t cell = cy * grid->columns + cx;
+			for (uint32_t e = grid->cell_start[cell]; e < grid->cell_start[cell + 1]; e++)
+			{
+				uint32_t i = grid->entries[e];
+				// Cells are sorted, nothing further in this one can win
+				if (i >= first) break;
+
+				if (alive[i] && box_overlap(box, boxes[i]))
+				{
+					first = i;
+					break;
+				}
+			}
+		}
+	}
+
+	return first;
+}
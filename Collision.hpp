@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Uniform grid broadphase. Boxes are bucketed by the cells they cover;
+// each cell lists its boxes in ascending index order so a query can stop
+// at the first hit and still return the lowest index overlapping box.
+
+const uint32_t COLLISION_NONE = 0xFFFFFFFF;
+const int32_t COLLISION_CELL_SIZE = 8;
+
+struct CollisionBox
+{
+	int32_t x, y;
+	int32_t width, height;
+};
+
+struct CollisionGrid
+{
+	size_t columns, rows;
+	uint32_t* cell_start;   // columns * rows + 1 offsets into entries
+	uint32_t* entries;
+};
+
+size_t collision_grid_memory_size(size_t width, size_t height);
+
+// Grid over a width x height area, living as long as arena
+void collision_grid_init(CollisionGrid* grid, size_t width, size_t height, Arena* arena);
+
+// Most cells a width x height box can cover, to size the scratch arena:
+// a build takes at most arena_size<uint32_t>(count * max cells) from it
+size_t collision_box_max_cells(size_t width, size_t height);
+
+// Rebuilds the grid over boxes. Boxes outside of the area are clamped to
+// the border cells. The entries come from scratch and have to stay there
+// for as long as the grid is queried.
+void collision_grid_build(CollisionGrid* grid, const CollisionBox* boxes, size_t count, Arena* scratch);
+
+// Returns the lowest index box overlapping box whose alive byte is set,
+// or COLLISION_NONE
+uint32_t collision_grid_first_hit(
+	const CollisionGrid* grid, const CollisionBox* boxes, const uint8_t* alive,
+	const CollisionBox& box
+);
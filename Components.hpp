@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Fixed.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+enum ComponentType : uint8_t
+{
+	COMPONENT_POSITION = 0,
+	COMPONENT_VELOCITY = 1,
+	COMPONENT_ALIEN = 2,
+	COMPONENT_DEATH_COUNTER = 3,
+	COMPONENT_PLAYER = 4,
+	COMPONENT_FORMATION_SLOT = 5,
+	COMPONENT_COUNT
+};
+
+enum AlienType : uint8_t
+{
+	ALIEN_DEAD = 0,
+	ALIEN_TYPE_A = 1,
+	ALIEN_TYPE_B = 2,
+	ALIEN_TYPE_C = 3,
+};
+
+// Positions are in pixels and velocities in pixels per tick, both as Fixed
+struct Position
+{
+	Fixed x, y;
+};
+
+struct Velocity
+{
+	Fixed x, y;
+};
+
+struct Alien
+{
+	AlienType type;
+};
+
+// Ticks left to show the death sprite once an alien is hit
+struct DeathCounter
+{
+	uint8_t ticks;
+};
+
+struct Player
+{
+	uint32_t life;
+};
+
+// Index of an alien's place in the formation, column + row * columns
+struct FormationSlot
+{
+	uint32_t index;
+};
+
+const size_t COMPONENT_SIZES[COMPONENT_COUNT] =
+{
+	sizeof(Position),
+	sizeof(Velocity),
+	sizeof(Alien),
+	sizeof(DeathCounter),
+	sizeof(Player),
+	sizeof(FormationSlot),
+};
@@ -0,0 +1,293 @@
+#include "Ecs.hpp"
+
+#include <bit>
+#include <cstring>
+
+static const size_t ENTITY_INDEX_MASK = 0xFFFFFF;
+
+// Rows of an archetype created without a capacity
+static const size_t DEFAULT_CAPACITY = 16;
+
+static size_t mask_bytes(size_t rows)
+{
+	return (rows + 7) / 8;
+}
+
+// The old array stays in the arena until its scope ends
+template<typename T>
+static T* grow_array(Arena* arena, T* data, size_t count, size_t capacity)
+{
+	T* grown = arena_push<T>(arena, capacity);
+	if (count) memcpy(grown, data, count * sizeof(T));
+	return grown;
+}
+
+static void archetype_reserve(World* world, Archetype* archetype, size_t capacity)
+{
+	if (capacity <= archetype->capacity) return;
+
+	size_t rows = archetype->count + archetype->num_spawned;
+	for (size_t c = 0; c < world->num_components; c++)
+	{
+		if (!(archetype->mask & component_bit(c))) continue;
+		size_t size = world->component_sizes[c];
+		archetype->columns[c] = grow_array(world->arena, archetype->columns[c], rows * size, capacity * size);
+	}
+
+	archetype->entities = grow_array(world->arena, archetype->entities, rows, capacity);
+	archetype->alive = grow_array(world->arena, archetype->alive, mask_bytes(rows), mask_bytes(capacity));
+	archetype->capacity = capacity;
+}
+
+size_t ecs_archetype_memory_size(const size_t* component_sizes, ComponentMask mask, size_t capacity)
+{
+	if (!capacity) capacity = DEFAULT_CAPACITY;
+	size_t size = arena_size<Entity>(capacity) + arena_size(mask_bytes(capacity));
+	for (size_t c = 0; c < ECS_MAX_COMPONENTS; c++)
+	{
+		if (mask & component_bit(c)) size += arena_size(capacity * component_sizes[c]);
+	}
+	return size;
+}
+
+size_t ecs_entities_memory_size(size_t capacity)
+{
+	return arena_size<EntityLocation>(capacity) + arena_size<uint8_t>(capacity) + arena_size<uint32_t>(capacity);
+}
+
+void ecs_init(World* world, const size_t* component_sizes, size_t num_components, Arena* arena)
+{
+	*world = {};
+	world->arena = arena;
+	world->num_components = num_components;
+	for (size_t c = 0; c < num_components; c++)
+	{
+		world->component_sizes[c] = component_sizes[c];
+	}
+}
+
+Archetype* ecs_archetype(World* world, ComponentMask mask, size_t capacity)
+{
+	for (size_t i = 0; i < world->num_archetypes; i++)
+	{
+		if (world->archetypes[i].mask == mask) return &world->archetypes[i];
+	}
+
+	if (world->num_archetypes == ECS_MAX_ARCHETYPES) return nullptr;
+
+	Archetype* archetype = &world->archetypes[world->num_archetypes++];
+	*archetype = {};
+	archetype->mask = mask;
+	archetype_reserve(world, archetype, capacity ? capacity : DEFAULT_CAPACITY);
+	return archetype;
+}
+
+void ecs_reserve(World* world, Archetype* archetype, size_t capacity)
+{
+	archetype_reserve(world, archetype, capacity);
+}
+
+void ecs_reserve_entities(World* world, size_t capacity)
+{
+	if (capacity <= world->entity_capacity) return;
+
+	world->locations = grow_array(world->arena, world->locations, world->num_entities, capacity);
+	world->generations = grow_array(world->arena, world->generations, world->num_entities, capacity);
+	world->free_entities = grow_array(world->arena, world->free_entities, world->num_free_entities, capacity);
+	world->entity_capacity = capacity;
+}
+
+Archetype* ecs_next(World* world, ComponentMask mask, size_t* cursor)
+{
+	while (*cursor < world->num_archetypes)
+	{
+		Archetype* archetype = &world->archetypes[(*cursor)++];
+		if ((archetype->mask & mask) == mask) return archetype;
+	}
+
+	return nullptr;
+}
+
+static Entity entity_create(World* world, uint32_t archetype, size_t row)
+{
+	uint32_t index;
+	if (world->num_free_entities)
+	{
+		index = world->free_entities[--world->num_free_entities];
+	}
+	else
+	{
+		if (world->num_entities == world->entity_capacity)
+		{
+			ecs_reserve_entities(world, world->entity_capacity ? 2 * world->entity_capacity : 256);
+		}
+
+		index = static_cast<uint32_t>(world->num_entities++);
+		world->generations[index] = 0;
+	}
+
+	world->locations[index] = { archetype, static_cast<uint32_t>(row) };
+	return (static_cast<Entity>(world->generations[index]) << 24) | index;
+}
+
+size_t ecs_spawn(World* world, Archetype* archetype, Entity* entity)
+{
+	size_t row = archetype->count + archetype->num_spawned;
+	if (row == archetype->capacity)
+	{
+		archetype_reserve(world, archetype, 2 * archetype->capacity);
+	}
+
+	uint32_t archetype_index = static_cast<uint32_t>(archetype - world->archetypes);
+	Entity created = entity_create(world, archetype_index, row);
+	archetype->entities[row] = created;
+	if (row % 8 == 0) archetype->alive[row / 8] = 0;
+	archetype->alive[row / 8] |= 1 << (row % 8);
+	++archetype->num_spawned;
+
+	if (entity) *entity = created;
+	return row;
+}
+
+bool ecs_alive(const World* world, Entity entity)
+{
+	size_t index = entity & ENTITY_INDEX_MASK;
+	return entity != ENTITY_NONE && index < world->num_entities &&
+		world->generations[index] == (entity >> 24);
+}
+
+void ecs_despawn(World* world, Entity entity)
+{
+	if (!ecs_alive(world, entity)) return;
+
+	const EntityLocation& location = world->locations[entity & ENTITY_INDEX_MASK];
+	ecs_despawn_row(&world->archetypes[location.archetype], location.row);
+}
+
+void ecs_despawn_row(Archetype* archetype, size_t row)
+{
+	archetype->alive[row / 8] &= ~(1 << (row % 8));
+	archetype->has_despawns = true;
+}
+
+void ecs_retain(Archetype* archetype, const uint8_t* mask)
+{
+	uint8_t removed = 0;
+	size_t full = archetype->count / 8;
+	for (size_t i = 0; i < full; i++)
+	{
+		removed |= archetype->alive[i] & ~mask[i];
+		archetype->alive[i] &= mask[i];
+	}
+
+	size_t tail = archetype->count % 8;
+	if (tail)
+	{
+		// Leave the bits of rows spawned this tick alone
+		uint8_t keep = static_cast<uint8_t>(mask[full] | ~((1 << tail) - 1));
+		removed |= archetype->alive[full] & ~keep;
+		archetype->alive[full] &= keep;
+	}
+
+	if (removed) archetype->has_despawns = true;
+}
+
+// Moves the rows whose alive bit is set to the front, keeping their order.
+// Common component sizes get a fixed-size copy the compiler can inline.
+template<size_t Size>
+static size_t compact_rows(uint8_t* data, size_t size, const uint8_t* alive, size_t rows)
+{
+	const size_t stride = Size ? Size : size;
+
+	size_t num_alive = 0;
+	for (size_t byte = 0; byte < mask_bytes(rows); byte++)
+	{
+		unsigned bits = alive[byte];
+		if (byte == rows / 8) bits &= (1u << (rows % 8)) - 1;
+
+		// Fully alive leading run needs no moves
+		if (bits == 0xFF && num_alive == 8 * byte)
+		{
+			num_alive += 8;
+			continue;
+		}
+
+		while (bits)
+		{
+			size_t row = 8 * byte + std::countr_zero(bits);
+			if (row != num_alive)
+			{
+				memcpy(data + num_alive * stride, data + row * stride, stride);
+			}
+			++num_alive;
+			bits &= bits - 1;
+		}
+	}
+
+	return num_alive;
+}
+
+static size_t compact_column(uint8_t* data, size_t size, const uint8_t* alive, size_t rows)
+{
+	switch (size)
+	{
+	case 1: return compact_rows<1>(data, size, alive, rows);
+	case 4: return compact_rows<4>(data, size, alive, rows);
+	case 8: return compact_rows<8>(data, size, alive, rows);
+	case 16: return compact_rows<16>(data, size, alive, rows);
+	default: return compact_rows<0>(data, size, alive, rows);
+	}
+}
+
+static void archetype_compact(World* world, Archetype* archetype)
+{
+	size_t rows = archetype->count + archetype->num_spawned;
+
+	// Release the ids of removed entities
+	size_t first_removed = rows;
+	for (size_t row = 0; row < rows; row++)
+	{
+		if (archetype->alive[row / 8] & (1 << (row % 8))) continue;
+		if (first_removed == rows) first_removed = row;
+
+		size_t index = archetype->entities[row] & ENTITY_INDEX_MASK;
+		++world->generations[index];
+		world->free_entities[world->num_free_entities++] = static_cast<uint32_t>(index);
+	}
+
+	size_t count = 0;
+	for (size_t c = 0; c < world->num_components; c++)
+	{
+		if (!(archetype->mask & component_bit(c))) continue;
+		count = compact_column(archetype->columns[c], world->component_sizes[c], archetype->alive, rows);
+	}
+	count = compact_column(reinterpret_cast<uint8_t*>(archetype->entities), sizeof(Entity),
+		archetype->alive, rows);
+
+	for (size_t row = first_removed; row < count; row++)
+	{
+		world->locations[archetype->entities[row] & ENTITY_INDEX_MASK].row = static_cast<uint32_t>(row);
+	}
+
+	memset(archetype->alive, 0xFF, mask_bytes(count));
+	archetype->count = count;
+}
+
+void ecs_flush(World* world)
+{
+	for (size_t i = 0; i < world->num_archetypes; i++)
+	{
+		Archetype* archetype = &world->archetypes[i];
+		if (archetype->has_despawns)
+		{
+			archetype_compact(world, archetype);
+		}
+		else
+		{
+			archetype->count += archetype->num_spawned;
+		}
+
+		archetype->num_spawned = 0;
+		archetype->has_despawns = false;
+	}
+}
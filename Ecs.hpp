@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Archetype based entity-component store. Every distinct set of components
+// gets its own archetype holding one tightly packed array per component, so
+// systems walk plain arrays. Spawns and despawns are deferred until
+// ecs_flush(), which applies them to each archetype in one batch. All
+// storage comes from an arena, so growing takes new arrays from it and
+// leaves the outgrown ones there. A game sizes its arena for exactly the
+// capacities it reserves, which makes growing past them throw
+// std::bad_alloc (Arena.hpp). Callers that take counts from outside, like
+// snapshot_restore(), check them against the capacity first.
+
+const size_t ECS_MAX_COMPONENTS = 32;
+const size_t ECS_MAX_ARCHETYPES = 64;
+
+typedef uint32_t ComponentMask;
+
+// 24-bit index, 8-bit generation
+typedef uint32_t Entity;
+const Entity ENTITY_NONE = 0xFFFFFFFF;
+
+struct Archetype
+{
+	ComponentMask mask;
+	size_t count;       // Rows visible to systems
+	size_t num_spawned; // Rows spawned since the last flush, after count
+	size_t capacity;
+	bool has_despawns;
+
+	Entity* entities;
+	uint8_t* alive;     // One bit per row, cleared by despawns
+	uint8_t* columns[ECS_MAX_COMPONENTS];
+};
+
+struct EntityLocation
+{
+	uint32_t archetype;
+	uint32_t row;
+};
+
+struct World
+{
+	Arena* arena;
+	size_t num_components;
+	size_t component_sizes[ECS_MAX_COMPONENTS];
+
+	size_t num_archetypes;
+	Archetype archetypes[ECS_MAX_ARCHETYPES];
+
+	size_t num_entities;
+	size_t entity_capacity;
+	EntityLocation* locations;
+	uint8_t* generations;
+	uint32_t* free_entities;
+	size_t num_free_entities;
+};
+
+constexpr ComponentMask component_bit(size_t component)
+{
+	return static_cast<ComponentMask>(1) << component;
+}
+
+// Arena bytes for an archetype of capacity rows and for an entity table
+// of capacity entities
+size_t ecs_archetype_memory_size(const size_t* component_sizes, ComponentMask mask, size_t capacity);
+size_t ecs_entities_memory_size(size_t capacity);
+
+// The world lives as long as arena and has nothing to free of its own
+void ecs_init(World* world, const size_t* component_sizes, size_t num_components, Arena* arena);
+
+// Finds the archetype storing exactly mask, creating it with room for
+// capacity rows if it does not exist yet
+Archetype* ecs_archetype(World* world, ComponentMask mask, size_t capacity);
+
+// Grows an archetype to hold at least capacity rows, allocating only when
+// that is more than it has
+void ecs_reserve(World* world, Archetype* archetype, size_t capacity);
+
+// Grows the entity table to hold at least capacity entities, allocating
+// only when that is more than it has
+void ecs_reserve_entities(World* world, size_t capacity);
+
+// Walks the archetypes containing every component in mask:
+//   size_t cursor = 0;
+//   while (Archetype* archetype = ecs_next(world, mask, &cursor)) { ... }
+Archetype* ecs_next(World* world, ComponentMask mask, size_t* cursor);
+
+template<typename T>
+T* ecs_column(const Archetype* archetype, size_t component)
+{
+	return reinterpret_cast<T*>(archetype->columns[component]);
+}
+
+// Reserves a row after the visible ones and returns its index. The caller
+// fills in the components; the entity becomes visible on the next flush.
+size_t ecs_spawn(World* world, Archetype* archetype, Entity* entity = nullptr);
+
+// Marks an entity or row for removal on the next flush
+void ecs_despawn(World* world, Entity entity);
+void ecs_despawn_row(Archetype* archetype, size_t row);
+
+// Marks every visible row whose bit is clear in mask for removal
+void ecs_retain(Archetype* archetype, const uint8_t* mask);
+
+bool ecs_alive(const World* world, Entity entity);
+
+template<typename T>
+T* ecs_get(World* world, Entity entity, size_t component)
+{
+	const EntityLocation& location = world->locations[entity & 0xFFFFFF];
+	return ecs_column<T>(&world->archetypes[location.archetype], component) + location.row;
+}
+
+// Applies pending despawns and spawns. Surviving rows keep their order.
+void ecs_flush(World* world);
@@ -0,0 +1,106 @@
+#include "File.hpp"
+
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool file_map(MappedFile* file, const char* path)
+{
+	*file = {};
+
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(handle);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		if (mapping) CloseHandle(mapping);
+		CloseHandle(handle);
+		return false;
+	}
+
+	file->data = static_cast<const uint8_t*>(view);
+	file->size = static_cast<size_t>(size.QuadPart);
+	file->file = handle;
+	file->mapping = mapping;
+#else
+	int handle = open(path, O_RDONLY);
+	if (handle < 0) return false;
+
+	struct stat info;
+	if (fstat(handle, &info) != 0 || info.st_size == 0)
+	{
+		close(handle);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, handle, 0);
+	close(handle);
+	if (view == MAP_FAILED) return false;
+
+	file->data = static_cast<const uint8_t*>(view);
+	file->size = static_cast<size_t>(info.st_size);
+#endif
+
+	return true;
+}
+
+void file_unmap(MappedFile* file)
+{
+	if (!file->data) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(file->data);
+	CloseHandle(file->mapping);
+	CloseHandle(file->file);
+#else
+	munmap(const_cast<uint8_t*>(file->data), file->size);
+#endif
+
+	*file = {};
+}
+
+bool file_write(const char* path, const uint8_t* data, size_t size)
+{
+	std::string temp_path = std::string(path) + ".tmp";
+	bool ok = false;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(temp_path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		DWORD written = 0;
+		ok = size <= MAXDWORD && WriteFile(file, data, static_cast<DWORD>(size), &written, NULL) && written == size;
+		ok = CloseHandle(file) && ok;
+		ok = ok && MoveFileExA(temp_path.c_str(), path, MOVEFILE_REPLACE_EXISTING);
+	}
+#else
+	int file = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file >= 0)
+	{
+		ok = write(file, data, size) == static_cast<ssize_t>(size);
+		ok = close(file) == 0 && ok;
+		ok = ok && rename(temp_path.c_str(), path) == 0;
+	}
+#endif
+
+	return ok;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Whole-file I/O for the binary formats (snapshots, the sprite atlas)
+
+// Read-only mapping of a file, shared with every other process mapping it
+struct MappedFile
+{
+	const uint8_t* data;
+	size_t size;
+#ifdef _WIN32
+	void* file;
+	void* mapping;
+#endif
+};
+
+// Returns false if path does not exist, is empty or cannot be mapped
+bool file_map(MappedFile* file, const char* path);
+void file_unmap(MappedFile* file);
+
+// Writes data to path through a temporary file so a crash never leaves a
+// torn file behind
+bool file_write(const char* path, const uint8_t* data, size_t size);
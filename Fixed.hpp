@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+// 24.8 fixed point used for all simulation positions and velocities.
+// Arithmetic wraps modulo 2^32 like the SIMD integer instructions do,
+// instead of relying on signed overflow, so every compiler and
+// optimization level produces the same bits.
+
+typedef int32_t Fixed;
+
+const int FIXED_SHIFT = 8;
+const Fixed FIXED_ONE = 1 << FIXED_SHIFT;
+
+constexpr Fixed fixed_from_int(int32_t value)
+{
+	return static_cast<Fixed>(static_cast<uint32_t>(value) << FIXED_SHIFT);
+}
+
+// Rounds toward negative infinity
+constexpr int32_t fixed_to_int(Fixed value)
+{
+	return value >> FIXED_SHIFT;
+}
+
+constexpr Fixed fixed_add(Fixed a, Fixed b)
+{
+	return static_cast<Fixed>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+}
+
+constexpr Fixed fixed_sub(Fixed a, Fixed b)
+{
+	return static_cast<Fixed>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+}
+
+constexpr Fixed fixed_mul(Fixed a, Fixed b)
+{
+	return static_cast<Fixed>(static_cast<uint64_t>(static_cast<int64_t>(a) * b) >> FIXED_SHIFT);
+}
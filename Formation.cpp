@@ -0,0 +1,167 @@
+#include "Formation.hpp"
+
+#include <bit>
+#include <cstring>
+
+static size_t bitset_words(size_t bits)
+{
+	return (bits + 63) / 64;
+}
+
+static void bit_set(uint64_t* words, size_t bit)
+{
+	words[bit / 64] |= uint64_t(1) << (bit % 64);
+}
+
+static void bit_clear(uint64_t* words, size_t bit)
+{
+	words[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+}
+
+static bool bit_test(const uint64_t* words, size_t bit)
+{
+	return (words[bit / 64] >> (bit % 64)) & 1;
+}
+
+static bool bitset_empty(const uint64_t* words, size_t count)
+{
+	for (size_t w = 0; w < count; w++)
+	{
+		if (words[w]) return false;
+	}
+	return true;
+}
+
+// Lowest set bit at or after bit
+static size_t bitset_next(const uint64_t* words, size_t count, size_t bit)
+{
+	size_t w = bit / 64;
+	if (w >= count) return FORMATION_NONE;
+
+	uint64_t word = words[w] & (~uint64_t(0) << (bit % 64));
+	while (!word)
+	{
+		if (++w == count) return FORMATION_NONE;
+		word = words[w];
+	}
+	return w * 64 + std::countr_zero(word);
+}
+
+static size_t bitset_last(const uint64_t* words, size_t count)
+{
+	for (size_t w = count; w-- > 0;)
+	{
+		if (words[w]) return w * 64 + 63 - std::countl_zero(words[w]);
+	}
+	return FORMATION_NONE;
+}
+
+static size_t bitset_count(const uint64_t* words, size_t count)
+{
+	size_t total = 0;
+	for (size_t w = 0; w < count; w++)
+	{
+		total += std::popcount(words[w]);
+	}
+	return total;
+}
+
+size_t formation_memory_size(size_t columns, size_t rows)
+{
+	size_t column_words = bitset_words(columns);
+	size_t row_words = bitset_words(rows);
+	return arena_size<uint64_t>(rows * column_words) + arena_size<uint64_t>(columns * row_words) +
+		arena_size<uint64_t>(column_words) + arena_size<uint64_t>(row_words);
+}
+
+void formation_init(Formation* formation, size_t columns, size_t rows, Arena* arena)
+{
+	formation->columns = columns;
+	formation->rows = rows;
+	formation->column_words = bitset_words(columns);
+	formation->row_words = bitset_words(rows);
+
+	formation->row_alive = arena_push<uint64_t>(arena, rows * formation->column_words);
+	formation->column_alive = arena_push<uint64_t>(arena, columns * formation->row_words);
+	formation->occupied_columns = arena_push<uint64_t>(arena, formation->column_words);
+	formation->occupied_rows = arena_push<uint64_t>(arena, formation->row_words);
+	formation_clear(formation);
+}
+
+void formation_clear(Formation* formation)
+{
+	memset(formation->row_alive, 0, formation->rows * formation->column_words * sizeof(uint64_t));
+	memset(formation->column_alive, 0, formation->columns * formation->row_words * sizeof(uint64_t));
+	memset(formation->occupied_columns, 0, formation->column_words * sizeof(uint64_t));
+	memset(formation->occupied_rows, 0, formation->row_words * sizeof(uint64_t));
+	formation->num_alive = 0;
+}
+
+void formation_set_alive(Formation* formation, size_t column, size_t row)
+{
+	if (formation_alive(*formation, column, row)) return;
+
+	bit_set(formation->row_alive + row * formation->column_words, column);
+	bit_set(formation->column_alive + column * formation->row_words, row);
+	bit_set(formation->occupied_columns, column);
+	bit_set(formation->occupied_rows, row);
+	++formation->num_alive;
+}
+
+void formation_kill(Formation* formation, size_t column, size_t row)
+{
+	if (!formation_alive(*formation, column, row)) return;
+
+	uint64_t* row_bits = formation->row_alive + row * formation->column_words;
+	uint64_t* column_bits = formation->column_alive + column * formation->row_words;
+	bit_clear(row_bits, column);
+	bit_clear(column_bits, row);
+	if (bitset_empty(row_bits, formation->column_words)) bit_clear(formation->occupied_rows, row);
+	if (bitset_empty(column_bits, formation->row_words)) bit_clear(formation->occupied_columns, column);
+	--formation->num_alive;
+}
+
+bool formation_alive(const Formation& formation, size_t column, size_t row)
+{
+	return bit_test(formation.row_alive + row * formation.column_words, column);
+}
+
+size_t formation_first_column(const Formation& formation)
+{
+	return bitset_next(formation.occupied_columns, formation.column_words, 0);
+}
+
+size_t formation_last_column(const Formation& formation)
+{
+	return bitset_last(formation.occupied_columns, formation.column_words);
+}
+
+size_t formation_bottom_row(const Formation& formation)
+{
+	return bitset_next(formation.occupied_rows, formation.row_words, 0);
+}
+
+size_t formation_top_row(const Formation& formation)
+{
+	return bitset_last(formation.occupied_rows, formation.row_words);
+}
+
+size_t formation_shooter(const Formation& formation, size_t column)
+{
+	return bitset_next(formation.column_alive + column * formation.row_words, formation.row_words, 0);
+}
+
+size_t formation_next_column(const Formation& formation, size_t column)
+{
+	return bitset_next(formation.occupied_columns, formation.column_words, column);
+}
+
+size_t formation_column_count(const Formation& formation, size_t column)
+{
+	return bitset_count(formation.column_alive + column * formation.row_words, formation.row_words);
+}
+
+size_t formation_row_count(const Formation& formation, size_t row)
+{
+	return bitset_count(formation.row_alive + row * formation.column_words, formation.column_words);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Alive bitsets over the alien formation grid, kept up to date as aliens
+// die so march and firing rules never scan the aliens. Row 0 is the bottom
+// row and column 0 the leftmost. Every row has a bitset over the columns
+// and every column one over the rows, plus one bit per row and per column
+// for whether it has anyone left. Queries are a few bit scans per 64
+// columns or rows, so constant time for the classic 11x5.
+
+const size_t FORMATION_NONE = SIZE_MAX;
+
+struct Formation
+{
+	size_t columns, rows;
+	size_t column_words, row_words;   // Words in a bitset over columns, rows
+	size_t num_alive;
+
+	uint64_t* row_alive;          // rows * column_words
+	uint64_t* column_alive;       // columns * row_words
+	uint64_t* occupied_columns;   // column_words
+	uint64_t* occupied_rows;      // row_words
+};
+
+size_t formation_memory_size(size_t columns, size_t rows);
+
+// Starts with every slot dead. The bitsets live as long as arena.
+void formation_init(Formation* formation, size_t columns, size_t rows, Arena* arena);
+void formation_clear(Formation* formation);
+
+void formation_set_alive(Formation* formation, size_t column, size_t row);
+void formation_kill(Formation* formation, size_t column, size_t row);
+bool formation_alive(const Formation& formation, size_t column, size_t row);
+
+// Leftmost and rightmost columns with an alien alive, FORMATION_NONE if
+// the formation is empty
+size_t formation_first_column(const Formation& formation);
+size_t formation_last_column(const Formation& formation);
+
+// Lowest and highest rows with an alien alive
+size_t formation_bottom_row(const Formation& formation);
+size_t formation_top_row(const Formation& formation);
+
+// Row of the lowest alien alive in column, the one allowed to shoot, or
+// FORMATION_NONE
+size_t formation_shooter(const Formation& formation, size_t column);
+
+// Next column at or after column with an alien alive, to visit every
+// shooter: for (c = formation_next_column(f, 0); c != FORMATION_NONE;
+// c = formation_next_column(f, c + 1))
+size_t formation_next_column(const Formation& formation, size_t column);
+
+size_t formation_column_count(const Formation& formation, size_t column);
+size_t formation_row_count(const Formation& formation, size_t row);
@@ -0,0 +1,284 @@
+// Generated by generate_gl_loader.py from the Khronos gl.xml, do not edit.
+
+#include "GL.hpp"
+
+#include <chrono>
+
+static GLLoadProc gl_load;
+static size_t gl_resolved;
+static int64_t gl_resolve_time;
+
+bool gl_init(GLLoadProc load)
+{
+	gl_load = load;
+	return load("glGetString") != nullptr;
+}
+
+void* gl_proc_address(const char* name)
+{
+	return gl_load(name);
+}
+
+size_t gl_resolved_count()
+{
+	return gl_resolved;
+}
+
+int64_t gl_resolve_nanoseconds()
+{
+	return gl_resolve_time;
+}
+
+static void* gl_resolve(const char* name)
+{
+	auto start = std::chrono::steady_clock::now();
+	void* proc = gl_load(name);
+	gl_resolve_time += (std::chrono::steady_clock::now() - start).count();
+	++gl_resolved;
+	return proc;
+}
+
+static void GLAPIENTRY gl_resolve_glActiveTexture(GLenum texture)
+{
+	gl_proc_glActiveTexture = reinterpret_cast<PFNGLACTIVETEXTUREPROC>(gl_resolve("glActiveTexture"));
+	gl_proc_glActiveTexture(texture);
+}
+PFNGLACTIVETEXTUREPROC gl_proc_glActiveTexture = gl_resolve_glActiveTexture;
+
+static void GLAPIENTRY gl_resolve_glAttachShader(GLuint program, GLuint shader)
+{
+	gl_proc_glAttachShader = reinterpret_cast<PFNGLATTACHSHADERPROC>(gl_resolve("glAttachShader"));
+	gl_proc_glAttachShader(program, shader);
+}
+PFNGLATTACHSHADERPROC gl_proc_glAttachShader = gl_resolve_glAttachShader;
+
+static void GLAPIENTRY gl_resolve_glBindTexture(GLenum target, GLuint texture)
+{
+	gl_proc_glBindTexture = reinterpret_cast<PFNGLBINDTEXTUREPROC>(gl_resolve("glBindTexture"));
+	gl_proc_glBindTexture(target, texture);
+}
+PFNGLBINDTEXTUREPROC gl_proc_glBindTexture = gl_resolve_glBindTexture;
+
+static void GLAPIENTRY gl_resolve_glBindVertexArray(GLuint array)
+{
+	gl_proc_glBindVertexArray = reinterpret_cast<PFNGLBINDVERTEXARRAYPROC>(gl_resolve("glBindVertexArray"));
+	gl_proc_glBindVertexArray(array);
+}
+PFNGLBINDVERTEXARRAYPROC gl_proc_glBindVertexArray = gl_resolve_glBindVertexArray;
+
+static void GLAPIENTRY gl_resolve_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+	gl_proc_glClearColor = reinterpret_cast<PFNGLCLEARCOLORPROC>(gl_resolve("glClearColor"));
+	gl_proc_glClearColor(red, green, blue, alpha);
+}
+PFNGLCLEARCOLORPROC gl_proc_glClearColor = gl_resolve_glClearColor;
+
+static void GLAPIENTRY gl_resolve_glCompileShader(GLuint shader)
+{
+	gl_proc_glCompileShader = reinterpret_cast<PFNGLCOMPILESHADERPROC>(gl_resolve("glCompileShader"));
+	gl_proc_glCompileShader(shader);
+}
+PFNGLCOMPILESHADERPROC gl_proc_glCompileShader = gl_resolve_glCompileShader;
+
+static GLuint GLAPIENTRY gl_resolve_glCreateProgram(void)
+{
+	gl_proc_glCreateProgram = reinterpret_cast<PFNGLCREATEPROGRAMPROC>(gl_resolve("glCreateProgram"));
+	return gl_proc_glCreateProgram();
+}
+PFNGLCREATEPROGRAMPROC gl_proc_glCreateProgram = gl_resolve_glCreateProgram;
+
+static GLuint GLAPIENTRY gl_resolve_glCreateShader(GLenum type)
+{
+	gl_proc_glCreateShader = reinterpret_cast<PFNGLCREATESHADERPROC>(gl_resolve("glCreateShader"));
+	return gl_proc_glCreateShader(type);
+}
+PFNGLCREATESHADERPROC gl_proc_glCreateShader = gl_resolve_glCreateShader;
+
+static void GLAPIENTRY gl_resolve_glDeleteProgram(GLuint program)
+{
+	gl_proc_glDeleteProgram = reinterpret_cast<PFNGLDELETEPROGRAMPROC>(gl_resolve("glDeleteProgram"));
+	gl_proc_glDeleteProgram(program);
+}
+PFNGLDELETEPROGRAMPROC gl_proc_glDeleteProgram = gl_resolve_glDeleteProgram;
+
+static void GLAPIENTRY gl_resolve_glDeleteShader(GLuint shader)
+{
+	gl_proc_glDeleteShader = reinterpret_cast<PFNGLDELETESHADERPROC>(gl_resolve("glDeleteShader"));
+	gl_proc_glDeleteShader(shader);
+}
+PFNGLDELETESHADERPROC gl_proc_glDeleteShader = gl_resolve_glDeleteShader;
+
+static void GLAPIENTRY gl_resolve_glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+	gl_proc_glDeleteVertexArrays = reinterpret_cast<PFNGLDELETEVERTEXARRAYSPROC>(gl_resolve("glDeleteVertexArrays"));
+	gl_proc_glDeleteVertexArrays(n, arrays);
+}
+PFNGLDELETEVERTEXARRAYSPROC gl_proc_glDeleteVertexArrays = gl_resolve_glDeleteVertexArrays;
+
+static void GLAPIENTRY gl_resolve_glDisable(GLenum cap)
+{
+	gl_proc_glDisable = reinterpret_cast<PFNGLDISABLEPROC>(gl_resolve("glDisable"));
+	gl_proc_glDisable(cap);
+}
+PFNGLDISABLEPROC gl_proc_glDisable = gl_resolve_glDisable;
+
+static void GLAPIENTRY gl_resolve_glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	gl_proc_glDrawArrays = reinterpret_cast<PFNGLDRAWARRAYSPROC>(gl_resolve("glDrawArrays"));
+	gl_proc_glDrawArrays(mode, first, count);
+}
+PFNGLDRAWARRAYSPROC gl_proc_glDrawArrays = gl_resolve_glDrawArrays;
+
+static void GLAPIENTRY gl_resolve_glGenTextures(GLsizei n, GLuint* textures)
+{
+	gl_proc_glGenTextures = reinterpret_cast<PFNGLGENTEXTURESPROC>(gl_resolve("glGenTextures"));
+	gl_proc_glGenTextures(n, textures);
+}
+PFNGLGENTEXTURESPROC gl_proc_glGenTextures = gl_resolve_glGenTextures;
+
+static void GLAPIENTRY gl_resolve_glGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+	gl_proc_glGenVertexArrays = reinterpret_cast<PFNGLGENVERTEXARRAYSPROC>(gl_resolve("glGenVertexArrays"));
+	gl_proc_glGenVertexArrays(n, arrays);
+}
+PFNGLGENVERTEXARRAYSPROC gl_proc_glGenVertexArrays = gl_resolve_glGenVertexArrays;
+
+static void GLAPIENTRY gl_resolve_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+	gl_proc_glGetActiveUniform = reinterpret_cast<PFNGLGETACTIVEUNIFORMPROC>(gl_resolve("glGetActiveUniform"));
+	gl_proc_glGetActiveUniform(program, index, bufSize, length, size, type, name);
+}
+PFNGLGETACTIVEUNIFORMPROC gl_proc_glGetActiveUniform = gl_resolve_glGetActiveUniform;
+
+static void GLAPIENTRY gl_resolve_glGetIntegerv(GLenum pname, GLint* data)
+{
+	gl_proc_glGetIntegerv = reinterpret_cast<PFNGLGETINTEGERVPROC>(gl_resolve("glGetIntegerv"));
+	gl_proc_glGetIntegerv(pname, data);
+}
+PFNGLGETINTEGERVPROC gl_proc_glGetIntegerv = gl_resolve_glGetIntegerv;
+
+static void GLAPIENTRY gl_resolve_glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
+{
+	gl_proc_glGetProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(gl_resolve("glGetProgramBinary"));
+	gl_proc_glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+}
+PFNGLGETPROGRAMBINARYPROC gl_proc_glGetProgramBinary = gl_resolve_glGetProgramBinary;
+
+static void GLAPIENTRY gl_resolve_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	gl_proc_glGetProgramInfoLog = reinterpret_cast<PFNGLGETPROGRAMINFOLOGPROC>(gl_resolve("glGetProgramInfoLog"));
+	gl_proc_glGetProgramInfoLog(program, bufSize, length, infoLog);
+}
+PFNGLGETPROGRAMINFOLOGPROC gl_proc_glGetProgramInfoLog = gl_resolve_glGetProgramInfoLog;
+
+static void GLAPIENTRY gl_resolve_glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+	gl_proc_glGetProgramiv = reinterpret_cast<PFNGLGETPROGRAMIVPROC>(gl_resolve("glGetProgramiv"));
+	gl_proc_glGetProgramiv(program, pname, params);
+}
+PFNGLGETPROGRAMIVPROC gl_proc_glGetProgramiv = gl_resolve_glGetProgramiv;
+
+static void GLAPIENTRY gl_resolve_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	gl_proc_glGetShaderInfoLog = reinterpret_cast<PFNGLGETSHADERINFOLOGPROC>(gl_resolve("glGetShaderInfoLog"));
+	gl_proc_glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+PFNGLGETSHADERINFOLOGPROC gl_proc_glGetShaderInfoLog = gl_resolve_glGetShaderInfoLog;
+
+static void GLAPIENTRY gl_resolve_glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+	gl_proc_glGetShaderiv = reinterpret_cast<PFNGLGETSHADERIVPROC>(gl_resolve("glGetShaderiv"));
+	gl_proc_glGetShaderiv(shader, pname, params);
+}
+PFNGLGETSHADERIVPROC gl_proc_glGetShaderiv = gl_resolve_glGetShaderiv;
+
+static const GLubyte* GLAPIENTRY gl_resolve_glGetString(GLenum name)
+{
+	gl_proc_glGetString = reinterpret_cast<PFNGLGETSTRINGPROC>(gl_resolve("glGetString"));
+	return gl_proc_glGetString(name);
+}
+PFNGLGETSTRINGPROC gl_proc_glGetString = gl_resolve_glGetString;
+
+static const GLubyte* GLAPIENTRY gl_resolve_glGetStringi(GLenum name, GLuint index)
+{
+	gl_proc_glGetStringi = reinterpret_cast<PFNGLGETSTRINGIPROC>(gl_resolve("glGetStringi"));
+	return gl_proc_glGetStringi(name, index);
+}
+PFNGLGETSTRINGIPROC gl_proc_glGetStringi = gl_resolve_glGetStringi;
+
+static GLint GLAPIENTRY gl_resolve_glGetUniformLocation(GLuint program, const GLchar* name)
+{
+	gl_proc_glGetUniformLocation = reinterpret_cast<PFNGLGETUNIFORMLOCATIONPROC>(gl_resolve("glGetUniformLocation"));
+	return gl_proc_glGetUniformLocation(program, name);
+}
+PFNGLGETUNIFORMLOCATIONPROC gl_proc_glGetUniformLocation = gl_resolve_glGetUniformLocation;
+
+static void GLAPIENTRY gl_resolve_glLinkProgram(GLuint program)
+{
+	gl_proc_glLinkProgram = reinterpret_cast<PFNGLLINKPROGRAMPROC>(gl_resolve("glLinkProgram"));
+	gl_proc_glLinkProgram(program);
+}
+PFNGLLINKPROGRAMPROC gl_proc_glLinkProgram = gl_resolve_glLinkProgram;
+
+static void GLAPIENTRY gl_resolve_glProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+	gl_proc_glProgramBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(gl_resolve("glProgramBinary"));
+	gl_proc_glProgramBinary(program, binaryFormat, binary, length);
+}
+PFNGLPROGRAMBINARYPROC gl_proc_glProgramBinary = gl_resolve_glProgramBinary;
+
+static void GLAPIENTRY gl_resolve_glProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+	gl_proc_glProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(gl_resolve("glProgramParameteri"));
+	gl_proc_glProgramParameteri(program, pname, value);
+}
+PFNGLPROGRAMPARAMETERIPROC gl_proc_glProgramParameteri = gl_resolve_glProgramParameteri;
+
+static void GLAPIENTRY gl_resolve_glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+	gl_proc_glShaderSource = reinterpret_cast<PFNGLSHADERSOURCEPROC>(gl_resolve("glShaderSource"));
+	gl_proc_glShaderSource(shader, count, string, length);
+}
+PFNGLSHADERSOURCEPROC gl_proc_glShaderSource = gl_resolve_glShaderSource;
+
+static void GLAPIENTRY gl_resolve_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+	gl_proc_glTexImage2D = reinterpret_cast<PFNGLTEXIMAGE2DPROC>(gl_resolve("glTexImage2D"));
+	gl_proc_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+PFNGLTEXIMAGE2DPROC gl_proc_glTexImage2D = gl_resolve_glTexImage2D;
+
+static void GLAPIENTRY gl_resolve_glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	gl_proc_glTexParameteri = reinterpret_cast<PFNGLTEXPARAMETERIPROC>(gl_resolve("glTexParameteri"));
+	gl_proc_glTexParameteri(target, pname, param);
+}
+PFNGLTEXPARAMETERIPROC gl_proc_glTexParameteri = gl_resolve_glTexParameteri;
+
+static void GLAPIENTRY gl_resolve_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+	gl_proc_glTexSubImage2D = reinterpret_cast<PFNGLTEXSUBIMAGE2DPROC>(gl_resolve("glTexSubImage2D"));
+	gl_proc_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+PFNGLTEXSUBIMAGE2DPROC gl_proc_glTexSubImage2D = gl_resolve_glTexSubImage2D;
+
+static void GLAPIENTRY gl_resolve_glUniform1f(GLint location, GLfloat v0)
+{
+	gl_proc_glUniform1f = reinterpret_cast<PFNGLUNIFORM1FPROC>(gl_resolve("glUniform1f"));
+	gl_proc_glUniform1f(location, v0);
+}
+PFNGLUNIFORM1FPROC gl_proc_glUniform1f = gl_resolve_glUniform1f;
+
+static void GLAPIENTRY gl_resolve_glUniform1i(GLint location, GLint v0)
+{
+	gl_proc_glUniform1i = reinterpret_cast<PFNGLUNIFORM1IPROC>(gl_resolve("glUniform1i"));
+	gl_proc_glUniform1i(location, v0);
+}
+PFNGLUNIFORM1IPROC gl_proc_glUniform1i = gl_resolve_glUniform1i;
+
+static void GLAPIENTRY gl_resolve_glUseProgram(GLuint program)
+{
+	gl_proc_glUseProgram = reinterpret_cast<PFNGLUSEPROGRAMPROC>(gl_resolve("glUseProgram"));
+	gl_proc_glUseProgram(program);
+}
+PFNGLUSEPROGRAMPROC gl_proc_glUseProgram = gl_resolve_glUseProgram;
@@ -0,0 +1,173 @@
+#pragma once
+
+// Generated by generate_gl_loader.py from the Khronos gl.xml, do not edit.
+// Holds only what the game uses. Entry points resolve on their first call
+// through the function given to gl_init(), on the thread with the context.
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef GLAPIENTRY
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#define GLAPIENTRY __stdcall
+#else
+#define GLAPIENTRY
+#endif
+#endif
+
+typedef char GLchar;
+typedef unsigned int GLenum;
+typedef float GLfloat;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned char GLubyte;
+typedef unsigned int GLuint;
+
+#define GL_ACTIVE_UNIFORMS 0x8B86
+#define GL_CLAMP_TO_EDGE 0x812F
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_DEPTH_TEST 0x0B71
+#define GL_EXTENSIONS 0x1F03
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_LINK_STATUS 0x8B82
+#define GL_MAJOR_VERSION 0x821B
+#define GL_MINOR_VERSION 0x821C
+#define GL_NEAREST 0x2600
+#define GL_NUM_EXTENSIONS 0x821D
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_RENDERER 0x1F01
+#define GL_RGB8 0x8051
+#define GL_RGBA 0x1908
+#define GL_TEXTURE0 0x84C0
+#define GL_TEXTURE_2D 0x0DE1
+#define GL_TEXTURE_MAG_FILTER 0x2800
+#define GL_TEXTURE_MIN_FILTER 0x2801
+#define GL_TEXTURE_WRAP_S 0x2802
+#define GL_TEXTURE_WRAP_T 0x2803
+#define GL_TRIANGLE_STRIP 0x0005
+#define GL_TRUE 1
+#define GL_UNSIGNED_INT_8_8_8_8 0x8035
+#define GL_VENDOR 0x1F00
+#define GL_VERSION 0x1F02
+#define GL_VERTEX_SHADER 0x8B31
+
+typedef void* (*GLLoadProc)(const char* name);
+
+// Sets where entry points come from, glfwGetProcAddress with GLFW. False
+// if load finds no glGetString, as when no context is current.
+bool gl_init(GLLoadProc load);
+
+// Looks an entry point up right away, null if the driver lacks it
+void* gl_proc_address(const char* name);
+
+// Entry points resolved so far and the time spent resolving them
+size_t gl_resolved_count();
+int64_t gl_resolve_nanoseconds();
+
+typedef void (GLAPIENTRY* PFNGLACTIVETEXTUREPROC)(GLenum texture);
+extern PFNGLACTIVETEXTUREPROC gl_proc_glActiveTexture;
+#define glActiveTexture gl_proc_glActiveTexture
+typedef void (GLAPIENTRY* PFNGLATTACHSHADERPROC)(GLuint program, GLuint shader);
+extern PFNGLATTACHSHADERPROC gl_proc_glAttachShader;
+#define glAttachShader gl_proc_glAttachShader
+typedef void (GLAPIENTRY* PFNGLBINDTEXTUREPROC)(GLenum target, GLuint texture);
+extern PFNGLBINDTEXTUREPROC gl_proc_glBindTexture;
+#define glBindTexture gl_proc_glBindTexture
+typedef void (GLAPIENTRY* PFNGLBINDVERTEXARRAYPROC)(GLuint array);
+extern PFNGLBINDVERTEXARRAYPROC gl_proc_glBindVertexArray;
+#define glBindVertexArray gl_proc_glBindVertexArray
+typedef void (GLAPIENTRY* PFNGLCLEARCOLORPROC)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+extern PFNGLCLEARCOLORPROC gl_proc_glClearColor;
+#define glClearColor gl_proc_glClearColor
+typedef void (GLAPIENTRY* PFNGLCOMPILESHADERPROC)(GLuint shader);
+extern PFNGLCOMPILESHADERPROC gl_proc_glCompileShader;
+#define glCompileShader gl_proc_glCompileShader
+typedef GLuint (GLAPIENTRY* PFNGLCREATEPROGRAMPROC)(void);
+extern PFNGLCREATEPROGRAMPROC gl_proc_glCreateProgram;
+#define glCreateProgram gl_proc_glCreateProgram
+typedef GLuint (GLAPIENTRY* PFNGLCREATESHADERPROC)(GLenum type);
+extern PFNGLCREATESHADERPROC gl_proc_glCreateShader;
+#define glCreateShader gl_proc_glCreateShader
+typedef void (GLAPIENTRY* PFNGLDELETEPROGRAMPROC)(GLuint program);
+extern PFNGLDELETEPROGRAMPROC gl_proc_glDeleteProgram;
+#define glDeleteProgram gl_proc_glDeleteProgram
+typedef void (GLAPIENTRY* PFNGLDELETESHADERPROC)(GLuint shader);
+extern PFNGLDELETESHADERPROC gl_proc_glDeleteShader;
+#define glDeleteShader gl_proc_glDeleteShader
+typedef void (GLAPIENTRY* PFNGLDELETEVERTEXARRAYSPROC)(GLsizei n, const GLuint* arrays);
+extern PFNGLDELETEVERTEXARRAYSPROC gl_proc_glDeleteVertexArrays;
+#define glDeleteVertexArrays gl_proc_glDeleteVertexArrays
+typedef void (GLAPIENTRY* PFNGLDISABLEPROC)(GLenum cap);
+extern PFNGLDISABLEPROC gl_proc_glDisable;
+#define glDisable gl_proc_glDisable
+typedef void (GLAPIENTRY* PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
+extern PFNGLDRAWARRAYSPROC gl_proc_glDrawArrays;
+#define glDrawArrays gl_proc_glDrawArrays
+typedef void (GLAPIENTRY* PFNGLGENTEXTURESPROC)(GLsizei n, GLuint* textures);
+extern PFNGLGENTEXTURESPROC gl_proc_glGenTextures;
+#define glGenTextures gl_proc_glGenTextures
+typedef void (GLAPIENTRY* PFNGLGENVERTEXARRAYSPROC)(GLsizei n, GLuint* arrays);
+extern PFNGLGENVERTEXARRAYSPROC gl_proc_glGenVertexArrays;
+#define glGenVertexArrays gl_proc_glGenVertexArrays
+typedef void (GLAPIENTRY* PFNGLGETACTIVEUNIFORMPROC)(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+extern PFNGLGETACTIVEUNIFORMPROC gl_proc_glGetActiveUniform;
+#define glGetActiveUniform gl_proc_glGetActiveUniform
+typedef void (GLAPIENTRY* PFNGLGETINTEGERVPROC)(GLenum pname, GLint* data);
+extern PFNGLGETINTEGERVPROC gl_proc_glGetIntegerv;
+#define glGetIntegerv gl_proc_glGetIntegerv
+typedef void (GLAPIENTRY* PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+extern PFNGLGETPROGRAMBINARYPROC gl_proc_glGetProgramBinary;
+#define glGetProgramBinary gl_proc_glGetProgramBinary
+typedef void (GLAPIENTRY* PFNGLGETPROGRAMINFOLOGPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+extern PFNGLGETPROGRAMINFOLOGPROC gl_proc_glGetProgramInfoLog;
+#define glGetProgramInfoLog gl_proc_glGetProgramInfoLog
+typedef void (GLAPIENTRY* PFNGLGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint* params);
+extern PFNGLGETPROGRAMIVPROC gl_proc_glGetProgramiv;
+#define glGetProgramiv gl_proc_glGetProgramiv
+typedef void (GLAPIENTRY* PFNGLGETSHADERINFOLOGPROC)(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+extern PFNGLGETSHADERINFOLOGPROC gl_proc_glGetShaderInfoLog;
+#define glGetShaderInfoLog gl_proc_glGetShaderInfoLog
+typedef void (GLAPIENTRY* PFNGLGETSHADERIVPROC)(GLuint shader, GLenum pname, GLint* params);
+extern PFNGLGETSHADERIVPROC gl_proc_glGetShaderiv;
+#define glGetShaderiv gl_proc_glGetShaderiv
+typedef const GLubyte* (GLAPIENTRY* PFNGLGETSTRINGPROC)(GLenum name);
+extern PFNGLGETSTRINGPROC gl_proc_glGetString;
+#define glGetString gl_proc_glGetString
+typedef const GLubyte* (GLAPIENTRY* PFNGLGETSTRINGIPROC)(GLenum name, GLuint index);
+extern PFNGLGETSTRINGIPROC gl_proc_glGetStringi;
+#define glGetStringi gl_proc_glGetStringi
+typedef GLint (GLAPIENTRY* PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const GLchar* name);
+extern PFNGLGETUNIFORMLOCATIONPROC gl_proc_glGetUniformLocation;
+#define glGetUniformLocation gl_proc_glGetUniformLocation
+typedef void (GLAPIENTRY* PFNGLLINKPROGRAMPROC)(GLuint program);
+extern PFNGLLINKPROGRAMPROC gl_proc_glLinkProgram;
+#define glLinkProgram gl_proc_glLinkProgram
+typedef void (GLAPIENTRY* PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+extern PFNGLPROGRAMBINARYPROC gl_proc_glProgramBinary;
+#define glProgramBinary gl_proc_glProgramBinary
+typedef void (GLAPIENTRY* PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+extern PFNGLPROGRAMPARAMETERIPROC gl_proc_glProgramParameteri;
+#define glProgramParameteri gl_proc_glProgramParameteri
+typedef void (GLAPIENTRY* PFNGLSHADERSOURCEPROC)(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+extern PFNGLSHADERSOURCEPROC gl_proc_glShaderSource;
+#define glShaderSource gl_proc_glShaderSource
+typedef void (GLAPIENTRY* PFNGLTEXIMAGE2DPROC)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+extern PFNGLTEXIMAGE2DPROC gl_proc_glTexImage2D;
+#define glTexImage2D gl_proc_glTexImage2D
+typedef void (GLAPIENTRY* PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLint param);
+extern PFNGLTEXPARAMETERIPROC gl_proc_glTexParameteri;
+#define glTexParameteri gl_proc_glTexParameteri
+typedef void (GLAPIENTRY* PFNGLTEXSUBIMAGE2DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+extern PFNGLTEXSUBIMAGE2DPROC gl_proc_glTexSubImage2D;
+#define glTexSubImage2D gl_proc_glTexSubImage2D
+typedef void (GLAPIENTRY* PFNGLUNIFORM1FPROC)(GLint location, GLfloat v0);
+extern PFNGLUNIFORM1FPROC gl_proc_glUniform1f;
+#define glUniform1f gl_proc_glUniform1f
+typedef void (GLAPIENTRY* PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
+extern PFNGLUNIFORM1IPROC gl_proc_glUniform1i;
+#define glUniform1i gl_proc_glUniform1i
+typedef void (GLAPIENTRY* PFNGLUSEPROGRAMPROC)(GLuint program);
+extern PFNGLUSEPROGRAMPROC gl_proc_glUseProgram;
+#define glUseProgram gl_proc_glUseProgram
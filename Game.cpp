@@ -0,0 +1,541 @@
+#include "Game.hpp"
+#include "Bullets.hpp"
+
+#include <cstring>
+
+GameConfig game_default_config()
+{
+	GameConfig config;
+	config.formation_columns = 11;
+	config.formation_rows = 5;
+	config.num_aliens = 55;
+	config.max_bullets = GAME_MAX_BULLETS;
+	config.fire_rate = 0;
+	config.seed = 1;
+	return config;
+}
+
+bool game_config_valid(const GameConfig& config)
+{
+	size_t columns = config.formation_columns, rows = config.formation_rows;
+	if (!columns || !rows || columns > GAME_CONFIG_LIMIT || rows > GAME_CONFIG_LIMIT / columns) return false;
+	return config.num_aliens && config.num_aliens <= columns * rows &&
+		config.max_bullets && config.max_bullets <= GAME_CONFIG_LIMIT;
+}
+
+size_t game_archetype_capacity(const GameConfig& config, ComponentMask mask)
+{
+	switch (mask)
+	{
+	case PLAYER_COMPONENTS: return 1;
+	case ALIEN_COMPONENTS: return config.num_aliens;
+	case BULLET_COMPONENTS: return config.max_bullets;
+	default: return 0;
+	}
+}
+
+size_t game_entity_capacity(const GameConfig& config)
+{
+	return 1 + config.num_aliens + config.max_bullets;
+}
+
+// Spreads n slots over span pixels, using the default spacing while it fits
+static size_t formation_offset(size_t i, size_t n, size_t spacing, size_t span)
+{
+	if (n < 2 || (n - 1) * spacing <= span) return i * spacing;
+	return i * span / (n - 1);
+}
+
+// Scratch for one tick: the bullet update's, the targets and their grid
+static size_t game_frame_memory_size(const GameConfig& config, const Sprites* sprites)
+{
+	size_t max_cells = 0;
+	for (size_t i = 0; i < ALIEN_SPRITES_MAX; i++)
+	{
+		size_t cells = collision_box_max_cells(sprites->aliens[i].width, sprites->aliens[i].height);
+		if (cells > max_cells) max_cells = cells;
+	}
+
+	size_t num_aliens = config.num_aliens;
+	return arena_size<uint8_t>(bullets_mask_size(config.max_bullets)) + arena_size<uint32_t>(config.max_bullets) +
+		arena_size<CollisionBox>(num_aliens) + arena_size<uint8_t>(num_aliens) +
+		2 * arena_size<uint32_t>(num_aliens) + arena_size<uint32_t>(num_aliens * max_cells);
+}
+
+// Everything that outlives a tick: the ECS, the formation and the grid
+static size_t game_state_memory_size(const GameConfig& config, size_t width, size_t height)
+{
+	return ecs_archetype_memory_size(COMPONENT_SIZES, PLAYER_COMPONENTS, game_archetype_capacity(config, PLAYER_COMPONENTS)) +
+		ecs_archetype_memory_size(COMPONENT_SIZES, ALIEN_COMPONENTS, game_archetype_capacity(config, ALIEN_COMPONENTS)) +
+		ecs_archetype_memory_size(COMPONENT_SIZES, BULLET_COMPONENTS, game_archetype_capacity(config, BULLET_COMPONENTS)) +
+		ecs_entities_memory_size(game_entity_capacity(config)) +
+		formation_memory_size(config.formation_columns, config.formation_rows) +
+		collision_grid_memory_size(width, height);
+}
+
+size_t game_memory_size(const GameConfig& config, const Sprites* sprites, size_t width, size_t height)
+{
+	// The state a second time for its pristine copy
+	return arena_size(game_frame_memory_size(config, sprites)) +
+		2 * game_state_memory_size(config, width, height) + arena_size<Game>(1);
+}
+
+void game_init(
+	Game* game, const GameConfig& config, const Sprites* sprites, size_t width, size_t height,
+	Arena* arena
+)
+{
+	size_t memory_size = game_memory_size(config, sprites, width, height);
+	if (arena) arena_init_sub(&game->memory, arena, memory_size);
+	else arena_init(&game->memory, memory_size);
+	arena_init_sub(&game->frame, &game->memory, game_frame_memory_size(config, sprites));
+
+	game->config = config;
+	game->width = width;
+	game->height = height;
+	game->score = 0;
+	game->tick = 0;
+	game->wave = 0;
+	random_seed(&game->random, config.seed);
+	game->sprites = sprites;
+
+	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	{
+		game->alien_animation[i].loop = true;
+		game->alien_animation[i].num_frames = 2;
+		game->alien_animation[i].frame_duration = 10;
+		game->alien_animation[i].time = 0;
+
+		game->alien_animation[i].frames = &sprites->aliens[2 * i];
+	}
+
+	ecs_init(&game->world, COMPONENT_SIZES, COMPONENT_COUNT, &game->memory);
+	game->players = ecs_archetype(&game->world, PLAYER_COMPONENTS, game_archetype_capacity(config, PLAYER_COMPONENTS));
+	game->aliens = ecs_archetype(&game->world, ALIEN_COMPONENTS, game_archetype_capacity(config, ALIEN_COMPONENTS));
+	game->bullets = ecs_archetype(&game->world, BULLET_COMPONENTS, game_archetype_capacity(config, BULLET_COMPONENTS));
+	ecs_reserve_entities(&game->world, game_entity_capacity(config));
+	formation_init(&game->formation, config.formation_columns, config.formation_rows, &game->memory);
+	collision_grid_init(&game->target_grid, width, height, &game->memory);
+	shields_init(game->shields, width);
+
+	game->jobs = nullptr;
+	game->bullet_alive = nullptr;
+	game->bullet_hits = nullptr;
+	game->num_targets = 0;
+	game->target_boxes = nullptr;
+	game->target_alive = nullptr;
+	game->target_archetypes = nullptr;
+	game->target_rows = nullptr;
+
+	size_t row = ecs_spawn(&game->world, game->players, &game->player);
+	Position& player_position = ecs_column<Position>(game->players, COMPONENT_POSITION)[row];
+	player_position.x = fixed_from_int(static_cast<int32_t>(width / 2 - sprites->player.width / 2));
+	player_position.y = fixed_from_int(32);
+	ecs_column<Player>(game->players, COMPONENT_PLAYER)[row].life = 3;
+
+	// Set alien positions and types. Formations larger than the classic
+	// 11x5 are squeezed into the same area.
+	size_t columns = config.formation_columns;
+	size_t rows = config.formation_rows;
+	for (size_t ai = 0; ai < config.num_aliens; ai++)
+	{
+		size_t xi = ai % columns;
+		size_t yi = ai / columns;
+
+		row = ecs_spawn(&game->world, game->aliens);
+		Alien& alien = ecs_column<Alien>(game->aliens, COMPONENT_ALIEN)[row];
+		alien.type = static_cast<AlienType>((5 - yi * 5 / rows) / 2 + 1);
+
+		const Sprite& sprite = sprites->aliens[2 * (alien.type - 1)];
+
+		Position& position = ecs_column<Position>(game->aliens, COMPONENT_POSITION)[row];
+		position.x = fixed_from_int(static_cast<int32_t>(formation_offset(xi, columns, 16, 160) + 20 +
+			(sprites->alien_death.width - sprite.width) / 2));
+		position.y = fixed_from_int(static_cast<int32_t>(formation_offset(yi, rows, 17, 68) + 128));
+
+		ecs_column<DeathCounter>(game->aliens, COMPONENT_DEATH_COUNTER)[row].ticks = 10;
+		ecs_column<FormationSlot>(game->aliens, COMPONENT_FORMATION_SLOT)[row].index = static_cast<uint32_t>(ai);
+		formation_set_alive(&game->formation, xi, yi);
+	}
+
+	ecs_flush(&game->world);
+
+	// Everything after the frame scratch is state, and nothing in it points
+	// outside of memory, so copying it back restores the state exactly
+	game->state_offset = game->frame.size;
+	game->state_size = game->memory.used - game->state_offset;
+	uint8_t* pristine_state = arena_push<uint8_t>(&game->memory, game->state_size);
+	Game* pristine = arena_push<Game>(&game->memory, 1);
+	memcpy(pristine_state, game->memory.data + game->state_offset, game->state_size);
+	game->pristine = pristine;
+	game->pristine_state = pristine_state;
+	*pristine = *game;
+}
+
+void game_free(Game* game)
+{
+	arena_free(&game->memory);
+}
+
+void game_reset(Game* game)
+{
+	JobSystem* jobs = game->jobs;
+	memcpy(game->memory.data + game->state_offset, game->pristine_state, game->state_size);
+	*game = *game->pristine;
+	game->jobs = jobs;
+}
+
+// Brings back the formation, shields and player for the next wave. The
+// score, tick, random stream and the player's lives carry over.
+static void game_next_wave(Game* game)
+{
+	uint64_t score = game->score;
+	uint64_t tick = game->tick;
+	uint32_t wave = game->wave;
+	Random random = game->random;
+	Player player = *ecs_get<Player>(&game->world, game->player, COMPONENT_PLAYER);
+
+	game_reset(game);
+
+	game->score = score;
+	game->tick = tick;
+	game->wave = wave + 1;
+	game->random = random;
+	*ecs_get<Player>(&game->world, game->player, COMPONENT_PLAYER) = player;
+}
+
+const Sprite& game_alien_sprite(const Game& game, AlienType type)
+{
+	const SpriteAnimation& animation = game.alien_animation[type - 1];
+	size_t current_frame = animation.time / animation.frame_duration;
+	return animation.frames[current_frame];
+}
+
+size_t game_aliens_left(Game* game)
+{
+	size_t count = 0;
+	size_t cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, ALIEN_COMPONENTS, &cursor))
+	{
+		count += archetype->count;
+	}
+	return count;
+}
+
+void game_rebuild_formation(Game* game)
+{
+	Formation* formation = &game->formation;
+	formation_clear(formation);
+
+	size_t cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, ALIEN_COMPONENTS, &cursor))
+	{
+		const Alien* aliens = ecs_column<Alien>(archetype, COMPONENT_ALIEN);
+		const FormationSlot* slots = ecs_column<FormationSlot>(archetype, COMPONENT_FORMATION_SLOT);
+		for (size_t ai = 0; ai < archetype->count; ai++)
+		{
+			if (aliens[ai].type == ALIEN_DEAD) continue;
+			formation_set_alive(formation, slots[ai].index % formation->columns, slots[ai].index / formation->columns);
+		}
+	}
+}
+
+static void game_update_animations(Game* game)
+{
+	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	{
+		SpriteAnimation& animation = game->alien_animation[i];
+		++animation.time;
+		if (animation.time == animation.num_frames * animation.frame_duration)
+		{
+			animation.time = 0;
+		}
+	}
+}
+
+static void game_simulate_aliens(Game* game)
+{
+	size_t cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, ALIEN_COMPONENTS, &cursor))
+	{
+		const Alien* aliens = ecs_column<Alien>(archetype, COMPONENT_ALIEN);
+		DeathCounter* death_counters = ecs_column<DeathCounter>(archetype, COMPONENT_DEATH_COUNTER);
+		for (size_t ai = 0; ai < archetype->count; ai++)
+		{
+			if (aliens[ai].type != ALIEN_DEAD) continue;
+
+			// Remove the alien once its death sprite has been shown
+			if (--death_counters[ai].ticks == 0)
+			{
+				ecs_despawn_row(archetype, ai);
+			}
+		}
+	}
+}
+
+static const Fixed BULLET_SPEED = fixed_from_int(2);
+
+// Bullets per collision job
+static const size_t BULLET_COLLISION_GRAIN = 2048;
+
+// Bullet hit marking a shield rather than an alien target
+static const uint32_t BULLET_HIT_SHIELD = COLLISION_NONE - 1;
+
+// Gathers the live aliens into collision targets and buckets them
+static void game_build_targets(Game* game)
+{
+	size_t num_aliens = 0;
+	size_t cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, ALIEN_COMPONENTS, &cursor))
+	{
+		num_aliens += archetype->count;
+	}
+
+	game->target_boxes = arena_push<CollisionBox>(&game->frame, num_aliens);
+	game->target_alive = arena_push<uint8_t>(&game->frame, num_aliens);
+	game->target_archetypes = arena_push<uint32_t>(&game->frame, num_aliens);
+	game->target_rows = arena_push<uint32_t>(&game->frame, num_aliens);
+
+	size_t num_targets = 0;
+	cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, ALIEN_COMPONENTS, &cursor))
+	{
+		const Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		const Alien* aliens = ecs_column<Alien>(archetype, COMPONENT_ALIEN);
+		for (size_t ai = 0; ai < archetype->count; ai++)
+		{
+			if (aliens[ai].type == ALIEN_DEAD) continue;
+
+			const Sprite& sprite = game_alien_sprite(*game, aliens[ai].type);
+			game->target_boxes[num_targets] = {
+				fixed_to_int(positions[ai].x), fixed_to_int(positions[ai].y),
+				static_cast<int32_t>(sprite.width), static_cast<int32_t>(sprite.height)
+			};
+			game->target_alive[num_targets] = 1;
+			game->target_archetypes[num_targets] = static_cast<uint32_t>(archetype - game->world.archetypes);
+			game->target_rows[num_targets] = static_cast<uint32_t>(ai);
+			++num_targets;
+		}
+	}
+
+	game->num_targets = num_targets;
+	collision_grid_build(&game->target_grid, game->target_boxes, num_targets, &game->frame);
+}
+
+static void game_kill_target(Game* game, uint32_t target)
+{
+	const Sprites& sprites = *game->sprites;
+
+	Archetype* archetype = &game->world.archetypes[game->target_archetypes[target]];
+	size_t row = game->target_rows[target];
+	Alien& alien = ecs_column<Alien>(archetype, COMPONENT_ALIEN)[row];
+	Position& position = ecs_column<Position>(archetype, COMPONENT_POSITION)[row];
+
+	game->score += 10 * (4 - alien.type);
+	game->target_alive[target] = 0;
+	alien.type = ALIEN_DEAD;
+
+	uint32_t slot = ecs_column<FormationSlot>(archetype, COMPONENT_FORMATION_SLOT)[row].index;
+	Formation* formation = &game->formation;
+	formation_kill(formation, slot % formation->columns, slot / formation->columns);
+
+	// NOTE: Hack to recenter death sprite
+	position.x = fixed_sub(position.x,
+		fixed_from_int(static_cast<int32_t>(sprites.alien_death.width - game->target_boxes[target].width) / 2));
+}
+
+static void game_simulate_bullets(Game* game)
+{
+	const Sprite& bullet_sprite = game->sprites->bullet;
+	game_build_targets(game);
+
+	size_t cursor = 0;
+	while (Archetype* archetype = ecs_next(&game->world, BULLET_COMPONENTS, &cursor))
+	{
+		game->bullet_alive = arena_push<uint8_t>(&game->frame, bullets_mask_size(archetype->capacity));
+		game->bullet_hits = arena_push<uint32_t>(&game->frame, archetype->capacity);
+
+		Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		uint8_t* alive = game->bullet_alive;
+		uint32_t* hits = game->bullet_hits;
+		bullets_integrate(positions, ecs_column<Velocity>(archetype, COMPONENT_VELOCITY),
+			archetype->count,
+			fixed_from_int(static_cast<int32_t>(bullet_sprite.height)),
+			fixed_from_int(static_cast<int32_t>(game->height)),
+			alive);
+
+		// Find each bullet's first hit against the shields and aliens as they
+		// were at the start of the tick. Workers only read shared state and
+		// write their own range of hits.
+		CollisionBox bullet_box = { 0, 0,
+			static_cast<int32_t>(bullet_sprite.width), static_cast<int32_t>(bullet_sprite.height) };
+		jobs_parallel_for(game->jobs, archetype->count, BULLET_COLLISION_GRAIN,
+			[&](size_t begin, size_t end)
+		{
+			CollisionBox box = bullet_box;
+			for (size_t bi = begin; bi < end; bi++)
+			{
+				hits[bi] = COLLISION_NONE;
+				if (!(alive[bi / 8] & (1 << (bi % 8)))) continue;
+
+				box.x = fixed_to_int(positions[bi].x);
+				box.y = fixed_to_int(positions[bi].y);
+				int32_t x, y;
+				if (shields_hit(game->shields, box, &x, &y) != SHIELD_COUNT)
+				{
+					hits[bi] = BULLET_HIT_SHIELD;
+					continue;
+				}
+				hits[bi] = collision_grid_first_hit(&game->target_grid,
+					game->target_boxes, game->target_alive, box);
+			}
+		});
+
+		// Resolve in bullet order so score, kills and erosion do not depend
+		// on the number of workers. Hits only ever disappear: a bullet whose
+		// shield pixels or alien were already taken by an earlier bullet
+		// gets rechecked against what remains, which gives the same result
+		// as a sequential pass.
+		for (size_t bi = 0; bi < archetype->count; bi++)
+		{
+			uint32_t target = hits[bi];
+			if (target == COLLISION_NONE) continue;
+
+			bullet_box.x = fixed_to_int(positions[bi].x);
+			bullet_box.y = fixed_to_int(positions[bi].y);
+			if (target == BULLET_HIT_SHIELD)
+			{
+				int32_t x, y;
+				size_t shield = shields_hit(game->shields, bullet_box, &x, &y);
+				if (shield != SHIELD_COUNT)
+				{
+					shield_erode(&game->shields[shield], x, y, SHIELD_DAMAGE_SHOT);
+					alive[bi / 8] &= ~(1 << (bi % 8));
+					continue;
+				}
+			}
+
+			if (target == BULLET_HIT_SHIELD || !game->target_alive[target])
+			{
+				target = collision_grid_first_hit(&game->target_grid,
+					game->target_boxes, game->target_alive, bullet_box);
+				if (target == COLLISION_NONE) continue;
+			}
+
+			game_kill_target(game, target);
+			alive[bi / 8] &= ~(1 << (bi % 8));
+		}
+
+		ecs_retain(archetype, alive);
+	}
+}
+
+static void game_simulate_player(Game* game, const GameInput& input)
+{
+	const Sprite& player_sprite = game->sprites->player;
+	Position& player = *ecs_get<Position>(&game->world, game->player, COMPONENT_POSITION);
+
+	// Input
+	Fixed player_move_dir = fixed_from_int(2 * input.move_dir);
+	if (player_move_dir != 0)
+	{
+		Fixed max_x = fixed_from_int(static_cast<int32_t>(game->width - player_sprite.width));
+		Fixed x = fixed_add(player.x, player_move_dir);
+		if (x >= max_x)
+		{
+			player.x = max_x;
+		}
+		else if (x <= 0)
+		{
+			player.x = 0;
+		}
+		else
+		{
+			player.x = x;
+		}
+	}
+
+	// Fire
+	Archetype* bullets = game->bullets;
+	if (input.fire && bullets->count + bullets->num_spawned < game->config.max_bullets)
+	{
+		size_t row = ecs_spawn(&game->world, bullets);
+		Position& position = ecs_column<Position>(bullets, COMPONENT_POSITION)[row];
+		position.x = fixed_add(player.x, fixed_from_int(static_cast<int32_t>(player_sprite.width / 2)));
+		position.y = fixed_add(player.y, fixed_from_int(static_cast<int32_t>(player_sprite.height)));
+		ecs_column<Velocity>(bullets, COMPONENT_VELOCITY)[row] = { 0, BULLET_SPEED };
+	}
+}
+
+static void game_simulate_auto_fire(Game* game)
+{
+	const Sprite& player_sprite = game->sprites->player;
+	const Position& player = *ecs_get<Position>(&game->world, game->player, COMPONENT_POSITION);
+
+	Archetype* bullets = game->bullets;
+	size_t rate = game->config.fire_rate;
+	for (size_t i = 0; i < rate; i++)
+	{
+		if (bullets->count + bullets->num_spawned >= game->config.max_bullets) break;
+
+		uint32_t x = random_range(&game->random, static_cast<uint32_t>(game->width));
+
+		size_t row = ecs_spawn(&game->world, bullets);
+		Position& position = ecs_column<Position>(bullets, COMPONENT_POSITION)[row];
+		position.x = fixed_from_int(static_cast<int32_t>(x));
+		position.y = fixed_add(player.y, fixed_from_int(static_cast<int32_t>(player_sprite.height)));
+		ecs_column<Velocity>(bullets, COMPONENT_VELOCITY)[row] = { 0, BULLET_SPEED };
+	}
+}
+
+void game_simulate(Game* game, const GameInput& input)
+{
+	arena_reset(&game->frame);
+	game_update_animations(game);
+	game_simulate_aliens(game);
+	game_simulate_bullets(game);
+	game_simulate_player(game, input);
+	game_simulate_auto_fire(game);
+
+	ecs_flush(&game->world);
+	++game->tick;
+
+	if (game_aliens_left(game) == 0) game_next_wave(game);
+}
+
+static void checksum_mix(uint64_t* hash, const void* data, size_t size)
+{
+	// FNV-1a
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		*hash = (*hash ^ bytes[i]) * 1099511628211ull;
+	}
+}
+
+uint64_t game_checksum(const Game& game)
+{
+	uint64_t hash = 14695981039346656037ull;
+	checksum_mix(&hash, &game.score, sizeof(game.score));
+	checksum_mix(&hash, &game.tick, sizeof(game.tick));
+	checksum_mix(&hash, &game.wave, sizeof(game.wave));
+	checksum_mix(&hash, &game.random, sizeof(game.random));
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		checksum_mix(&hash, game.shields[i].rows, sizeof(game.shields[i].rows));
+	}
+
+	for (size_t a = 0; a < game.world.num_archetypes; a++)
+	{
+		const Archetype& archetype = game.world.archetypes[a];
+		uint64_t count = archetype.count;
+		checksum_mix(&hash, &count, sizeof(count));
+		for (size_t c = 0; c < game.world.num_components; c++)
+		{
+			if (!(archetype.mask & component_bit(c))) continue;
+			checksum_mix(&hash, archetype.columns[c], archetype.count * game.world.component_sizes[c]);
+		}
+	}
+
+	return hash;
+}
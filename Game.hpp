@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Arena.hpp"
+#include "Collision.hpp"
+#include "Components.hpp"
+#include "Ecs.hpp"
+#include "Formation.hpp"
+#include "Jobs.hpp"
+#include "Random.hpp"
+#include "Shields.hpp"
+#include "Sprites.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+const size_t GAME_MAX_BULLETS = 200;
+// Upper bound for formation slots and for the bullet capacity, which keeps
+// the sizes of the game's arrays from overflowing
+const size_t GAME_CONFIG_LIMIT = size_t(1) << 22;
+
+const ComponentMask PLAYER_COMPONENTS =
+	component_bit(COMPONENT_POSITION) | component_bit(COMPONENT_PLAYER);
+const ComponentMask ALIEN_COMPONENTS =
+	component_bit(COMPONENT_POSITION) | component_bit(COMPONENT_ALIEN) | component_bit(COMPONENT_DEATH_COUNTER) |
+	component_bit(COMPONENT_FORMATION_SLOT);
+const ComponentMask BULLET_COMPONENTS =
+	component_bit(COMPONENT_POSITION) | component_bit(COMPONENT_VELOCITY);
+
+struct GameConfig
+{
+	size_t formation_columns, formation_rows;
+	size_t num_aliens;
+	size_t max_bullets;
+	// Bullets fired automatically every tick at random columns
+	size_t fire_rate;
+	uint64_t seed;
+};
+
+struct GameInput
+{
+	int move_dir;
+	bool fire;
+};
+
+struct Game
+{
+	GameConfig config;
+	size_t width, height;
+	uint64_t score;
+	uint64_t tick;
+	// Waves cleared so far
+	uint32_t wave;
+	// Source of all randomness in the simulation
+	Random random;
+
+	World world;
+	Archetype* players;
+	Archetype* aliens;
+	Archetype* bullets;
+	Entity player;
+
+	// Which formation slots still hold a live alien
+	Formation formation;
+
+	Shield shields[SHIELD_COUNT];
+
+	const Sprites* sprites;
+	SpriteAnimation alien_animation[ALIEN_ANIMATION_MAX];
+
+	// Optional pool for the collision pass, null to run on the caller
+	JobSystem* jobs;
+
+	// Everything the game allocates, sized by game_memory_size(). frame is
+	// the part of it holding scratch for one tick, reset as the tick starts.
+	Arena memory;
+	Arena frame;
+
+	// The game and its state in memory as game_init() left them, kept in
+	// memory for game_reset() to copy back
+	const Game* pristine;
+	const uint8_t* pristine_state;
+	size_t state_offset, state_size;
+
+	// Scratch for the bullet update, sized to the bullet capacity
+	uint8_t* bullet_alive;
+	uint32_t* bullet_hits;
+
+	// Live aliens as collision targets, rebuilt every tick
+	size_t num_targets;
+	CollisionBox* target_boxes;
+	uint8_t* target_alive;
+	uint32_t* target_archetypes;
+	uint32_t* target_rows;
+	CollisionGrid target_grid;
+};
+
+GameConfig game_default_config();
+
+// Whether game_init() can take config: a non-empty formation with room for
+// every alien, at least one bullet, and counts within GAME_CONFIG_LIMIT.
+// Configs read from files must pass this before use.
+bool game_config_valid(const GameConfig& config);
+
+// Rows game_init() reserves for the archetype storing mask, 0 for masks
+// the game never creates, and entities it reserves in all. The arena has
+// no room to grow past either.
+size_t game_archetype_capacity(const GameConfig& config, ComponentMask mask);
+size_t game_entity_capacity(const GameConfig& config);
+
+// Arena bytes a game takes, all of it allocated by game_init()
+size_t game_memory_size(const GameConfig& config, const Sprites* sprites, size_t width, size_t height);
+
+// The game's memory comes from arena when it is given, and is then released
+// with arena rather than by game_free(). Otherwise the game makes a single
+// allocation of its own. Either way the simulation never allocates.
+void game_init(
+	Game* game, const GameConfig& config, const Sprites* sprites, size_t width, size_t height,
+	Arena* arena = nullptr
+);
+void game_free(Game* game);
+
+// Puts the game back the way game_init() left it with two block copies,
+// keeping only jobs. Does not allocate.
+void game_reset(Game* game);
+
+// Advances the simulation by one tick. The result depends only on the
+// config, the inputs and the tick count: positions are fixed point with
+// wrapping arithmetic, and randomness comes from the seeded game->random.
+// A tick that ends with every alien gone starts the next wave.
+void game_simulate(Game* game, const GameInput& input);
+
+const Sprite& game_alien_sprite(const Game& game, AlienType type);
+
+// Aliens still in the formation, including ones playing their death animation
+size_t game_aliens_left(Game* game);
+
+// Recomputes game->formation from the aliens, after their columns have
+// been overwritten as by snapshot_restore()
+void game_rebuild_formation(Game* game);
+
+// Hash of the simulation state, equal for two games exactly when they
+// went through the same ticks
+uint64_t game_checksum(const Game& game);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit FNV-1a, usable at compile time. A hash can be carried on by
+// passing it back in as the seed.
+
+const uint64_t HASH_SEED = 14695981039346656037ull;
+
+constexpr uint64_t hash_bytes(const char* data, size_t size, uint64_t hash = HASH_SEED)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// Hash of text up to its terminating zero
+constexpr uint64_t hash_string(const char* text, uint64_t hash = HASH_SEED)
+{
+	while (*text)
+	{
+		hash = (hash ^ static_cast<uint8_t>(*text++)) * 1099511628211ull;
+	}
+	return hash;
+}
@@ -0,0 +1,62 @@
+#include "InputQueue.hpp"
+
+#include <chrono>
+
+int64_t input_time_now()
+{
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void input_queue_init(InputQueue* queue)
+{
+	queue->read.store(0, std::memory_order_relaxed);
+	queue->write.store(0, std::memory_order_relaxed);
+}
+
+bool input_queue_push(InputQueue* queue, InputKey key, bool pressed, int64_t time)
+{
+	uint64_t write = queue->write.load(std::memory_order_relaxed);
+	uint64_t read = queue->read.load(std::memory_order_acquire);
+	if (write - read == INPUT_QUEUE_SIZE) return false;
+
+	InputEvent& event = queue->events[write & (INPUT_QUEUE_SIZE - 1)];
+	event.time = time;
+	event.key = key;
+	event.pressed = pressed;
+	queue->write.store(write + 1, std::memory_order_release);
+	return true;
+}
+
+bool input_queue_pop(InputQueue* queue, InputEvent* event)
+{
+	uint64_t read = queue->read.load(std::memory_order_relaxed);
+	uint64_t write = queue->write.load(std::memory_order_acquire);
+	if (read == write) return false;
+
+	*event = queue->events[read & (INPUT_QUEUE_SIZE - 1)];
+	queue->read.store(read + 1, std::memory_order_release);
+	return true;
+}
+
+void input_state_apply(InputState* state, const InputEvent& event)
+{
+	switch (event.key)
+	{
+	case INPUT_KEY_LEFT: state->left = event.pressed; break;
+	case INPUT_KEY_RIGHT: state->right = event.pressed; break;
+	case INPUT_KEY_FIRE: if (event.pressed) ++state->fire_presses; break;
+	case INPUT_KEY_REWIND: state->rewind = event.pressed; break;
+	case INPUT_KEY_RESTART: if (event.pressed) state->restart = true; break;
+	case INPUT_KEY_QUIT: if (event.pressed) state->quit = true; break;
+	}
+}
+
+GameInput input_state_next(InputState* state)
+{
+	GameInput input;
+	input.move_dir = static_cast<int>(state->right) - static_cast<int>(state->left);
+	input.fire = state->fire_presses > 0;
+	if (input.fire) --state->fire_presses;
+	return input;
+}
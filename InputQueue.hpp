@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Game.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Keyboard events passed from the thread polling the window to the
+// simulation through a single-producer, single-consumer ring. Every event
+// keeps the time it was received, so nothing is lost between ticks and
+// latency can be measured from it.
+
+enum InputKey : uint8_t
+{
+	INPUT_KEY_LEFT,
+	INPUT_KEY_RIGHT,
+	INPUT_KEY_FIRE,
+	INPUT_KEY_REWIND,
+	INPUT_KEY_RESTART,
+	INPUT_KEY_QUIT,
+};
+
+struct InputEvent
+{
+	int64_t time;      // input_time_now() when the event arrived
+	InputKey key;
+	bool pressed;
+};
+
+// Power of two. At 60 ticks per second this is seconds of events.
+const size_t INPUT_QUEUE_SIZE = 256;
+
+struct InputQueue
+{
+	// Written by the consumer and producer only, kept on separate cache lines
+	std::atomic<uint64_t> read;
+	uint8_t read_padding[64 - sizeof(std::atomic<uint64_t>)];
+	std::atomic<uint64_t> write;
+	uint8_t write_padding[64 - sizeof(std::atomic<uint64_t>)];
+
+	InputEvent events[INPUT_QUEUE_SIZE];
+};
+
+// What the drained events add up to
+struct InputState
+{
+	bool left, right;
+	bool rewind;
+	bool restart;   // Pressed since the last tick
+	bool quit;
+	// Fire presses not yet turned into shots, one per tick
+	uint32_t fire_presses;
+};
+
+// Nanoseconds on a monotonic clock
+int64_t input_time_now();
+
+void input_queue_init(InputQueue* queue);
+
+// Producer side. Returns false, dropping the event, if the queue is full.
+bool input_queue_push(InputQueue* queue, InputKey key, bool pressed, int64_t time);
+
+// Consumer side. Returns false if the queue is empty.
+bool input_queue_pop(InputQueue* queue, InputEvent* event);
+
+void input_state_apply(InputState* state, const InputEvent& event);
+
+// Input for the next tick, using up one pending fire press
+GameInput input_state_next(InputState* state);
@@ -0,0 +1,216 @@
+#include "Jobs.hpp"
+
+// Index of the calling thread within the job system it belongs to
+static thread_local size_t worker_index = 0;
+
+static const size_t JOB_MAX_BATCH = 256;
+
+// Chase-Lev deque operations. Only the owning worker pushes and pops.
+
+static bool deque_push(JobDeque* deque, Job* job)
+{
+	int64_t bottom = deque->bottom.load(std::memory_order_relaxed);
+	int64_t top = deque->top.load(std::memory_order_acquire);
+	if (bottom - top >= static_cast<int64_t>(JOB_DEQUE_SIZE)) return false;
+
+	deque->jobs[bottom & (JOB_DEQUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+	deque->bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+static Job* deque_pop(JobDeque* deque)
+{
+	int64_t bottom = deque->bottom.load(std::memory_order_relaxed) - 1;
+	deque->bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = deque->top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = deque->jobs[bottom & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (top == bottom)
+	{
+		// Last job, race the thieves for it
+		if (!deque->top.compare_exchange_strong(top, top + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = nullptr;
+		}
+		deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+static Job* deque_steal(JobDeque* deque)
+{
+	int64_t top = deque->top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = deque->bottom.load(std::memory_order_acquire);
+	if (top >= bottom) return nullptr;
+
+	Job* job = deque->jobs[top & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (!deque->top.compare_exchange_strong(top, top + 1,
+		std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+
+	return job;
+}
+
+static Job* jobs_find(JobSystem* jobs, size_t index)
+{
+	if (Job* job = deque_pop(&jobs->deques[index])) return job;
+
+	for (size_t i = 1; i < jobs->num_workers; i++)
+	{
+		size_t victim = (index + i) % jobs->num_workers;
+		if (Job* job = deque_steal(&jobs->deques[victim])) return job;
+	}
+
+	return nullptr;
+}
+
+static void jobs_notify(JobSystem* jobs)
+{
+	jobs->epoch.fetch_add(1, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> lock(jobs->mutex);
+	}
+	jobs->wake.notify_all();
+}
+
+static void jobs_execute(Job* job)
+{
+	job->function(job->data, job->begin, job->end);
+	job->counter->fetch_sub(1, std::memory_order_release);
+}
+
+// Queues a job on the calling worker, running it inline if the deque is full
+static void jobs_submit(JobSystem* jobs, Job* job)
+{
+	if (!deque_push(&jobs->deques[worker_index], job))
+	{
+		jobs_execute(job);
+	}
+}
+
+static void jobs_worker(JobSystem* jobs, size_t index)
+{
+	worker_index = index;
+
+	while (jobs->running.load(std::memory_order_acquire))
+	{
+		uint64_t epoch = jobs->epoch.load(std::memory_order_acquire);
+		if (Job* job = jobs_find(jobs, index))
+		{
+			jobs_execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(jobs->mutex);
+		jobs->wake.wait(lock, [&]()
+		{
+			return jobs->epoch.load(std::memory_order_acquire) != epoch ||
+				!jobs->running.load(std::memory_order_acquire);
+		});
+	}
+}
+
+void jobs_init(JobSystem* jobs, size_t num_workers)
+{
+	if (num_workers == 0) num_workers = 1;
+
+	jobs->num_workers = num_workers;
+	jobs->deques = new JobDeque[num_workers];
+	for (size_t i = 0; i < num_workers; i++)
+	{
+		jobs->deques[i].top = 0;
+		jobs->deques[i].bottom = 0;
+	}
+
+	jobs->running = true;
+	jobs->epoch = 0;
+
+	worker_index = 0;
+
+	jobs->threads = new std::thread[num_workers - 1];
+	for (size_t i = 1; i < num_workers; i++)
+	{
+		jobs->threads[i - 1] = std::thread(jobs_worker, jobs, i);
+	}
+}
+
+void jobs_free(JobSystem* jobs)
+{
+	jobs->running = false;
+	jobs_notify(jobs);
+
+	for (size_t i = 1; i < jobs->num_workers; i++)
+	{
+		jobs->threads[i - 1].join();
+	}
+
+	delete[] jobs->threads;
+	delete[] jobs->deques;
+}
+
+void jobs_wait(JobSystem* jobs, std::atomic<size_t>* counter)
+{
+	while (counter->load(std::memory_order_acquire) != 0)
+	{
+		if (Job* job = jobs_find(jobs, worker_index))
+		{
+			jobs_execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+size_t jobs_worker_index()
+{
+	return worker_index;
+}
+
+void jobs_parallel_for(JobSystem* jobs, size_t count, size_t grain, JobFunction fn, void* data)
+{
+	if (grain == 0) grain = 1;
+	if (!jobs || jobs->num_workers == 1 || count <= grain)
+	{
+		if (count) fn(data, 0, count);
+		return;
+	}
+
+	size_t num_jobs = (count + grain - 1) / grain;
+	if (num_jobs > JOB_MAX_BATCH)
+	{
+		grain = (count + JOB_MAX_BATCH - 1) / JOB_MAX_BATCH;
+		num_jobs = (count + grain - 1) / grain;
+	}
+
+	Job batch[JOB_MAX_BATCH];
+	std::atomic<size_t> counter(num_jobs);
+
+	// Push in reverse so the owner pops the first chunk first
+	for (size_t i = num_jobs; i-- > 0;)
+	{
+		Job& job = batch[i];
+		job.function = fn;
+		job.data = data;
+		job.begin = i * grain;
+		job.end = job.begin + grain < count ? job.begin + grain : count;
+		job.counter = &counter;
+		jobs_submit(jobs, &job);
+	}
+
+	jobs_notify(jobs);
+	jobs_wait(jobs, &counter);
+}
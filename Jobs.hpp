@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Work-stealing thread pool. Each worker owns a deque: it pushes and pops
+// jobs at the bottom, idle workers steal from the top of the others. The
+// thread calling jobs_init() is worker 0 and is the only non-pool thread
+// allowed to submit work, or one thread at a time taking its place; it runs
+// jobs itself while waiting on them.
+
+typedef void (*JobFunction)(void* data, size_t begin, size_t end);
+
+struct Job
+{
+	JobFunction function;
+	void* data;
+	size_t begin, end;
+	std::atomic<size_t>* counter; // Decremented once the job has run
+};
+
+const size_t JOB_DEQUE_SIZE = 4096;
+
+struct JobDeque
+{
+	std::atomic<int64_t> top;
+	std::atomic<int64_t> bottom;
+	std::atomic<Job*> jobs[JOB_DEQUE_SIZE];
+};
+
+struct JobSystem
+{
+	size_t num_workers;
+	JobDeque* deques;
+	std::thread* threads;
+
+	std::atomic<bool> running;
+	std::atomic<uint64_t> epoch;
+	std::mutex mutex;
+	std::condition_variable wake;
+};
+
+// Starts num_workers - 1 pool threads next to the calling thread
+void jobs_init(JobSystem* jobs, size_t num_workers);
+void jobs_free(JobSystem* jobs);
+
+// Runs fn over [0, count) split into chunks of about grain items and waits
+// for all of them. The chunking depends only on count and grain, never on
+// the number of workers. A null job system runs everything inline.
+void jobs_parallel_for(JobSystem* jobs, size_t count, size_t grain, JobFunction fn, void* data);
+
+template<typename F>
+void jobs_parallel_for(JobSystem* jobs, size_t count, size_t grain, const F& body)
+{
+	jobs_parallel_for(jobs, count, grain,
+		[](void* data, size_t begin, size_t end) { (*static_cast<const F*>(data))(begin, end); },
+		const_cast<F*>(&body));
+}
+
+// Runs the calling thread's share of the work until counter reaches zero
+void jobs_wait(JobSystem* jobs, std::atomic<size_t>* counter);
+
+// Index of the calling thread within its job system, for per-worker
+// scratch. 0 on threads that are not workers.
+size_t jobs_worker_index();
@@ -0,0 +1,79 @@
+#include "Latency.hpp"
+
+#include <cstdio>
+
+static double milliseconds(int64_t nanoseconds)
+{
+	return static_cast<double>(nanoseconds) / 1e6;
+}
+
+void latency_init(LatencyHistogram* histogram)
+{
+	*histogram = {};
+}
+
+void latency_record(LatencyHistogram* histogram, int64_t latency)
+{
+	if (latency < 0) latency = 0;
+
+	size_t bucket = static_cast<size_t>(latency / LATENCY_BUCKET_NS);
+	if (bucket >= LATENCY_BUCKETS) bucket = LATENCY_BUCKETS - 1;
+	++histogram->buckets[bucket];
+
+	if (!histogram->count || latency < histogram->min) histogram->min = latency;
+	if (!histogram->count || latency > histogram->max) histogram->max = latency;
+	histogram->total += latency;
+	++histogram->count;
+}
+
+int64_t latency_percentile(const LatencyHistogram& histogram, double fraction)
+{
+	uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(histogram.count));
+	uint64_t seen = 0;
+	for (size_t b = 0; b + 1 < LATENCY_BUCKETS; b++)
+	{
+		seen += histogram.buckets[b];
+		if (seen > rank)
+		{
+			int64_t edge = static_cast<int64_t>(b + 1) * LATENCY_BUCKET_NS;
+			return edge < histogram.max ? edge : histogram.max;
+		}
+	}
+	return histogram.max;
+}
+
+void latency_report(const LatencyHistogram& histogram, const char* name)
+{
+	if (!histogram.count)
+	{
+		printf("%s: no samples\n", name);
+		return;
+	}
+
+	printf("%s: %zu samples, min %.2f ms, mean %.2f ms, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+		name, histogram.count,
+		milliseconds(histogram.min), milliseconds(histogram.total) / static_cast<double>(histogram.count),
+		milliseconds(latency_percentile(histogram, 0.5)), milliseconds(latency_percentile(histogram, 0.9)),
+		milliseconds(latency_percentile(histogram, 0.99)), milliseconds(histogram.max));
+
+	uint64_t largest = 0;
+	for (size_t b = 0; b < LATENCY_BUCKETS; b++)
+	{
+		if (histogram.buckets[b] > largest) largest = histogram.buckets[b];
+	}
+
+	const size_t BAR_WIDTH = 50;
+	for (size_t b = 0; b < LATENCY_BUCKETS; b++)
+	{
+		uint64_t count = histogram.buckets[b];
+		if (!count) continue;
+
+		char bar[BAR_WIDTH + 1];
+		size_t length = static_cast<size_t>((count * BAR_WIDTH + largest - 1) / largest);
+		for (size_t i = 0; i < length; i++) bar[i] = '#';
+		bar[length] = '\0';
+
+		printf("  %6.1f%s ms %8llu %s\n", milliseconds(static_cast<int64_t>(b) * LATENCY_BUCKET_NS),
+			b + 1 == LATENCY_BUCKETS ? "+" : " ", static_cast<unsigned long long>(count), bar);
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Histogram of input latencies in nanoseconds, with LATENCY_BUCKET_NS wide
+// buckets. The last bucket also holds everything beyond it.
+
+const size_t LATENCY_BUCKETS = 100;
+const int64_t LATENCY_BUCKET_NS = 1000000;
+
+struct LatencyHistogram
+{
+	size_t count;
+	int64_t min, max, total;
+	uint64_t buckets[LATENCY_BUCKETS];
+};
+
+void latency_init(LatencyHistogram* histogram);
+void latency_record(LatencyHistogram* histogram, int64_t latency);
+
+// Upper edge of the bucket holding the given fraction of the samples, or
+// the maximum if it falls in the last bucket
+int64_t latency_percentile(const LatencyHistogram& histogram, double fraction);
+
+// Prints the summary and a bar per non-empty bucket
+void latency_report(const LatencyHistogram& histogram, const char* name);
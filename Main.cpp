@@ -1,203 +1,481 @@
 #include "OurShader.hpp"
-
+#include "Batch.hpp"
+#include "Atlas.hpp"
+#include "Buffer.hpp"
+#include "File.hpp"
+#include "Game.hpp"
+#include "GL.hpp"
+#include "InputQueue.hpp"
+#include "Latency.hpp"
+#include "Options.hpp"
+#include "RandomInput.hpp"
+#include "Replay.hpp"
+#include "RenderState.hpp"
+#include "Rewind.hpp"
+#include "Shaders.hpp"
+#include "Snapshot.hpp"
+
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
-#include <glad/glad.h>
+#include <thread>
+#define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
-const int BUFFER_WIDTH = 224;
-const int BUFFER_HEIGHT = 256;
-const int GAME_MAX_BULLETS = 200;
+// Ticks between snapshot saves
+const uint64_t SNAPSHOT_INTERVAL = 600;
 
-bool game_running = false;
-int player_move_dir = 1;
-int move_dir = 0;
-bool fire_pressed = 0;
-size_t score = 0;
+const size_t TICKS_PER_SECOND = 60;
+// Upper bound for the rewind history
+const size_t REWIND_MAX_BYTES = 256 * 1024 * 1024;
 
-enum AlienType : uint8_t
-{
-	ALIEN_DEAD = 0,
-	ALIEN_TYPE_A = 1,
-	ALIEN_TYPE_B = 2,
-	ALIEN_TYPE_C = 3,
-};
+// Cleared by whichever of the window and the simulation stops first
+std::atomic<bool> game_running = false;
 
-struct Alien
-{
-	size_t x, y;
-	AlienType type;
-};
-
-struct Player
-{
-	size_t x, y;
-	size_t life;
-};
+// Filled by key_callback, drained at the start of every tick
+InputQueue input_queue;
+InputState input_state = {};
 
-struct Bullet
+void error_callback(int error, const char* description)
 {
-	size_t x, y;
-	int dir;
-};
+	fprintf(stderr, "Error: %d: %s\n", error, description);
+}
 
-struct Sprite
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
-	size_t width, height;
-	uint8_t* data;
-};
+	if (action != GLFW_PRESS && action != GLFW_RELEASE) return;
 
-struct SpriteAnimation
-{
-	bool loop;
-	size_t num_frames;
-	size_t frame_duration;
-	size_t time;
-	Sprite** frames;
-};
+	InputKey input_key;
+	switch (key)
+	{
+	case GLFW_KEY_ESCAPE: input_key = INPUT_KEY_QUIT; break;
+	case GLFW_KEY_RIGHT: input_key = INPUT_KEY_RIGHT; break;
+	case GLFW_KEY_LEFT: input_key = INPUT_KEY_LEFT; break;
+	case GLFW_KEY_SPACE: input_key = INPUT_KEY_FIRE; break;
+	case GLFW_KEY_BACKSPACE: input_key = INPUT_KEY_REWIND; break;
+	case GLFW_KEY_R: input_key = INPUT_KEY_RESTART; break;
+	default: return;
+	}
 
-struct Game
-{
-	size_t width, height;
-	size_t num_aliens;
-	size_t num_bullets;
-	Alien* aliens;
-	Player player;
-	Bullet bullets[GAME_MAX_BULLETS];
-};
+	input_queue_push(&input_queue, input_key, action == GLFW_PRESS, input_time_now());
+}
 
-struct Buffer
+// Applies every queued key event to input_state. Returns when the oldest
+// press that can move the player or fire arrived, or 0 if there was none.
+int64_t input_drain()
 {
-	size_t width, height;
-	uint32_t* data;
-};
+	int64_t oldest_press = 0;
+	InputEvent event;
+	while (input_queue_pop(&input_queue, &event))
+	{
+		input_state_apply(&input_state, event);
 
+		bool visible = event.key == INPUT_KEY_LEFT || event.key == INPUT_KEY_RIGHT || event.key == INPUT_KEY_FIRE;
+		if (visible && event.pressed && !oldest_press) oldest_press = event.time;
+	}
+	return oldest_press;
+}
 
-uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b)
+void stress_report(
+	const Game& game, size_t ticks, size_t entity_ticks, std::chrono::nanoseconds sim_time,
+	size_t frames, size_t sprite_frames, std::chrono::nanoseconds render_time
+)
 {
-	return (r << 24) | (g << 16) | (b << 8) | 255;
+	double sim_ns = static_cast<double>(sim_time.count());
+	double render_ns = static_cast<double>(render_time.count());
+	double entities = entity_ticks ? static_cast<double>(entity_ticks) : 1.0;
+	double sprites = sprite_frames ? static_cast<double>(sprite_frames) : 1.0;
+	printf("tick %llu: %zu aliens, %zu bullets | sim %.1f us/tick, %.2f ns/entity | "
+		"render %.1f us/frame, %.2f ns/sprite\n",
+		static_cast<unsigned long long>(game.tick), game.aliens->count, game.bullets->count,
+		sim_ns / ticks / 1000.0, sim_ns / entities,
+		frames ? render_ns / frames / 1000.0 : 0.0, render_ns / sprites);
 }
 
-void buffer_clear(Buffer* buffer, uint32_t color)
+// Runs one tick with input from the replay if there is one, then the bot,
+// then the keyboard. Returns false once the replay has run out.
+bool game_step(Game* game, const Options& options, Replay* replay, Replay* recording, RandomInput* bot)
 {
-	for (size_t i = 0; i < buffer->width * buffer->height; i++)
+	GameInput input;
+	if (replay)
 	{
-		buffer->data[i] = color;
+		if (!replay_next(replay, &input)) return false;
 	}
+	else if (bot)
+	{
+		input = random_input_next(bot);
+	}
+	else if (options.headless)
+	{
+		input = { 0, false };
+	}
+	else
+	{
+		input = input_state_next(&input_state);
+	}
+
+	if (recording) replay_record(recording, input);
+	game_simulate(game, input);
+
+	if (options.snapshot_path && game->tick % SNAPSHOT_INTERVAL == 0)
+	{
+		snapshot_save(*game, options.snapshot_path);
+	}
+	return true;
 }
 
-void buffer_draw_sprite(
-	Buffer* buffer, const Sprite& sprite, size_t x, size_t y, uint32_t color
-)
+// Steps options.num_games independent games as fast as possible. Extra
+// games get their own seeds and run in parallel on the job system, one
+// game per job; a single game uses the pool for its collision pass instead.
+int run_headless(Game* game, const Sprites& sprites, const Options& options, Replay* replay, Replay* recording)
 {
-	for (size_t xi = 0; xi < sprite.width; xi++)
+	size_t num_games = options.num_games;
+	JobSystem* jobs = game->jobs;
+
+	// The extra games share one block, their configs differ only in seed
+	Arena memory;
+	arena_init(&memory, (num_games - 1) * game_memory_size(options.game, &sprites, BUFFER_WIDTH, BUFFER_HEIGHT));
+
+	Game** games = new Game*[num_games];
+	games[0] = game;
+	for (size_t i = 1; i < num_games; i++)
 	{
-		for (size_t yi = 0; yi < sprite.height; yi++)
+		GameConfig config = options.game;
+		config.seed = options.game.seed + i;
+		games[i] = new Game;
+		game_init(games[i], config, &sprites, BUFFER_WIDTH, BUFFER_HEIGHT, &memory);
+	}
+	if (num_games > 1) game->jobs = nullptr;
+
+	RandomInput* bots = new RandomInput[num_games];
+	for (size_t i = 0; i < num_games; i++)
+	{
+		random_input_init(&bots[i], options.game.seed, i);
+	}
+
+	uint64_t start_tick = game->tick;
+	uint64_t* ticks = new uint64_t[num_games];
+
+	auto start = std::chrono::steady_clock::now();
+	jobs_parallel_for(jobs, num_games, 1, [&](size_t begin, size_t end)
+	{
+		Buffer buffer = { BUFFER_WIDTH, BUFFER_HEIGHT, nullptr };
+		if (options.render) buffer.data = new uint32_t[buffer.width * buffer.height];
+
+		for (size_t i = begin; i < end; i++)
 		{
-			size_t sy = sprite.height - 1 + y - yi;
-			size_t sx = x + xi;
-			if (sprite.data[yi * sprite.width + xi] && sy < buffer->height && sx < buffer->width)
+			Game* current = games[i];
+			RandomInput* bot = options.input == INPUT_RANDOM ? &bots[i] : nullptr;
+			uint64_t first_tick = current->tick;
+			while (!options.max_ticks || current->tick < options.max_ticks)
 			{
-				buffer->data[sy * buffer->width + sx] = color;
+				if (!game_step(current, options, i == 0 ? replay : nullptr, i == 0 ? recording : nullptr, bot)) break;
+				if (buffer.data) buffer_draw_game(&buffer, *current, rgb_to_uint32(0, 128, 0));
 			}
+			ticks[i] = current->tick - first_tick;
 		}
+
+		delete[] buffer.data;
+	});
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	uint64_t total_ticks = 0;
+	for (size_t i = 0; i < num_games; i++)
+	{
+		total_ticks += ticks[i];
 	}
-}
 
-bool sprite_overlap_check(
-	const Sprite& sp_a, size_t x_a, size_t y_a,
-	const Sprite& sp_b, size_t x_b, size_t y_b
-)
-{
-	if (x_a < x_b + sp_b.width && x_a + sp_a.width > x_b &&
-		y_a < y_b + sp_b.height && y_a + sp_a.height > y_b)
+	// Cores actually busy: one per game, or the whole pool for a single game
+	size_t workers = jobs ? jobs->num_workers : 1;
+	size_t cores = num_games > 1 && num_games < workers ? num_games : workers;
+
+	double seconds = elapsed.count() > 0.0 ? elapsed.count() : 1e-9;
+	double ticks_per_second = static_cast<double>(total_ticks) / seconds;
+	printf("%zu game%s, %llu ticks in %.3f s: %.0f ticks/s, %.0f ticks/s per core on %zu core%s\n",
+		num_games, num_games == 1 ? "" : "s", static_cast<unsigned long long>(total_ticks), elapsed.count(),
+		ticks_per_second, ticks_per_second / static_cast<double>(cores), cores, cores == 1 ? "" : "s");
+	if (num_games == 1)
 	{
-		return true;
+		printf("Ran ticks %llu to %llu, score %llu\n", static_cast<unsigned long long>(start_tick),
+			static_cast<unsigned long long>(game->tick), static_cast<unsigned long long>(game->score));
 	}
 
-	return false;
+	for (size_t i = 1; i < num_games; i++)
+	{
+		delete games[i];
+	}
+	arena_free(&memory);
+	delete[] games;
+	delete[] bots;
+	delete[] ticks;
+	game->jobs = jobs;
+
+	return 0;
 }
 
-void buffer_draw_text(
-	Buffer* buffer,
-	const Sprite& text_spritesheet,
-	const char* text,
-	size_t x, size_t y,
-	uint32_t color)
+// Steps options.num_games games in lockstep through the batch API with
+// random actions, the way a training loop would
+int run_batch(const Sprites& sprites, const Options& options, JobSystem* jobs)
 {
-	size_t xp = x;
-	size_t stride = text_spritesheet.width * text_spritesheet.height;
-	Sprite sprite = text_spritesheet;
-	for (const char* charp = text; *charp != '\0'; ++charp)
+	size_t num_games = options.num_games;
+	BatchEnv env;
+	batch_init(&env, num_games, options.game, &sprites, jobs, options.episode_ticks);
+
+	Observer observer = {};
+	uint8_t* pooled = nullptr;
+	if (options.observe_width)
+	{
+		if (!observer_init(&observer, options.observe_width, options.observe_height, options.pooling,
+			BUFFER_WIDTH, BUFFER_HEIGHT))
+		{
+			fprintf(stderr, "Unsupported observation size %zux%zu\n", options.observe_width, options.observe_height);
+			batch_free(&env);
+			return 1;
+		}
+		batch_set_observer(&env, &observer);
+		pooled = new uint8_t[num_games * options.observe_width * options.observe_height];
+	}
+
+	uint8_t* actions = new uint8_t[num_games];
+	int32_t* rewards = new int32_t[num_games];
+	uint8_t* dones = new uint8_t[num_games];
+	uint32_t* observations = options.render ? new uint32_t[num_games * BUFFER_WIDTH * BUFFER_HEIGHT] : nullptr;
+
+	Random random;
+	random_seed(&random, options.game.seed, 1);
+
+	batch_reset(&env, observations, pooled);
+
+	uint64_t episodes = 0;
+	int64_t total_reward = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t step = 0; step < options.max_ticks; step++)
 	{
-		char character = *charp - 32;
-		if (character < 0 || character >= 65) continue;
+		for (size_t i = 0; i < num_games; i++)
+		{
+			actions[i] = static_cast<uint8_t>(random_range(&random, ACTION_COUNT));
+		}
 
-		sprite.data = text_spritesheet.data + character * stride;
-		buffer_draw_sprite(buffer, sprite, xp, y, color);
-		xp += sprite.width + 1;
+		batch_step(&env, actions, rewards, dones, observations, pooled);
+
+		for (size_t i = 0; i < num_games; i++)
+		{
+			total_reward += rewards[i];
+			episodes += dones[i];
+		}
 	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	size_t workers = jobs ? jobs->num_workers : 1;
+	size_t cores = num_games < workers ? num_games : workers;
+	double seconds = elapsed.count() > 0.0 ? elapsed.count() : 1e-9;
+	double steps_per_second = static_cast<double>(options.max_ticks * num_games) / seconds;
+	printf("%zu games x %zu steps in %.3f s: %.0f game steps/s, %.0f per core on %zu core%s\n",
+		num_games, options.max_ticks, elapsed.count(),
+		steps_per_second, steps_per_second / static_cast<double>(cores), cores, cores == 1 ? "" : "s");
+	printf("%llu episodes finished, total reward %lld\n",
+		static_cast<unsigned long long>(episodes), static_cast<long long>(total_reward));
+
+	delete[] actions;
+	delete[] rewards;
+	delete[] dones;
+	delete[] observations;
+	delete[] pooled;
+	batch_free(&env);
+	observer_free(&observer);
+
+	return 0;
 }
 
-void buffer_draw_number(
-	Buffer* buffer,
-	const Sprite& number_spritesheet,
-	size_t number,
-	size_t x, size_t y,
-	uint32_t color
-)
+// Room for two full keyframes per segment and half a snapshot per delta
+size_t rewind_capacity(const Game& game, size_t ticks)
+{
+	size_t state_size = snapshot_size(game, true);
+	size_t segments = ticks / REWIND_KEYFRAME_INTERVAL + 2;
+	size_t capacity = 2 * segments * state_size + ticks * state_size / 2;
+	return capacity < REWIND_MAX_BYTES ? capacity : REWIND_MAX_BYTES;
+}
+
+// Input-to-photon tracking for --latency. A key press is tagged if the
+// tick that consumes it moves the player or fires. Every state published
+// from then on carries the tag until the render thread has swapped one of
+// them to the screen. Tags are numbered by the tracker rather than by
+// tick, since restarts and rewinds move the tick backwards.
+struct LatencyTracker
 {
-	uint8_t digits[64];
-	size_t num_digits = 0;
+	// Key press to the end of the consuming tick, simulation thread only
+	LatencyHistogram to_tick;
+	// Key press to glfwSwapBuffers returning, render thread only
+	LatencyHistogram to_photon;
+
+	// Simulation thread only. tagged_time is 0 when no tag is waiting to
+	// be shown, tagged_press counts the tags so far.
+	int64_t tagged_time;
+	uint64_t tagged_press;
+	// Last tag on screen, written by the render thread
+	std::atomic<uint64_t> shown_press;
+};
+
+// Simulation side of the window, ticking on its own thread and handing
+// every tick to the render thread through the render queue
+struct WindowSim
+{
+	Game* game;
+	const Options* options;
+	Replay* replay;
+	Replay* recording;
+	Rewind* rewind;
+	RandomInput* bot;
+	RenderQueue* render_queue;
+	// Null unless measuring latency
+	LatencyTracker* latency;
+
+	// Stress statistics, reported every STRESS_REPORT_TICKS
+	size_t stress_ticks;
+	size_t stress_entity_ticks;
+	std::chrono::nanoseconds stress_sim_time;
+
+	// Render cost, added up by the render thread and collected by the
+	// stress reports
+	std::atomic<uint64_t> render_frames;
+	std::atomic<uint64_t> render_sprites;
+	std::atomic<int64_t> render_ns;
+};
+
+const size_t STRESS_REPORT_TICKS = 300;
+
+// Runs one tick of the windowed game. Returns false once it should stop.
+bool window_tick(WindowSim* sim)
+{
+	Game* game = sim->game;
+	const Options& options = *sim->options;
+
+	int64_t press_time = input_drain();
+	if (input_state.quit) return false;
+
+	// What the tick starts from, to see whether a press had an effect
+	Fixed player_x = ecs_get<Position>(&game->world, game->player, COMPONENT_POSITION)->x;
+	uint32_t fire_presses = input_state.fire_presses;
+
+	// A replay decides what happens, otherwise start over from tick 0 with
+	// a fresh recording
+	if (input_state.restart && !sim->replay)
+	{
+		game_reset(game);
+		if (sim->recording)
+		{
+			replay_free(sim->recording);
+			replay_init(sim->recording, game->config);
+		}
+		if (sim->rewind) rewind_record(sim->rewind, *game);
+		if (sim->latency) sim->latency->tagged_time = 0;
+	}
+	input_state.restart = false;
 
-	size_t current_number = number;
-	do
+	uint64_t oldest, newest;
+	if (sim->rewind && input_state.rewind && rewind_range(sim->rewind, &oldest, &newest))
+	{
+		// Step back one tick at a time while held, playing on from there
+		// once released
+		if (game->tick > oldest) rewind_restore(sim->rewind, game, game->tick - 1);
+	}
+	else
 	{
-		digits[num_digits++] = current_number % 10;
-		current_number = current_number / 10;
-	} while (current_number > 0);
+		if (!game_step(game, options, sim->replay, sim->recording, sim->bot)) return false;
+		if (sim->rewind) rewind_record(sim->rewind, *game);
+	}
 
-	size_t xp = x;
-	size_t stride = number_spritesheet.width * number_spritesheet.height;
-	Sprite sprite = number_spritesheet;
-	for (size_t i = 0; i < num_digits; ++i)
+	LatencyTracker* latency = sim->latency;
+	if (latency && press_time)
 	{
-		uint8_t digit = digits[num_digits - i - 1];
-		sprite.data = number_spritesheet.data + digit * stride;
-		buffer_draw_sprite(buffer, sprite, xp, y, color);
-		xp += sprite.width + 1;
+		bool moved = ecs_get<Position>(&game->world, game->player, COMPONENT_POSITION)->x != player_x;
+		bool fired = input_state.fire_presses < fire_presses;
+		// Presses without a visible effect, or landing while an earlier
+		// one is still on its way to the screen, are not measured
+		bool tag_free = !latency->tagged_time ||
+			latency->tagged_press <= latency->shown_press.load(std::memory_order_acquire);
+		if ((moved || fired) && tag_free)
+		{
+			latency->tagged_time = press_time;
+			++latency->tagged_press;
+			latency_record(&latency->to_tick, input_time_now() - press_time);
+		}
 	}
+
+	return !options.max_ticks || game->tick < options.max_ticks;
 }
 
-void error_callback(int error, const char* description)
+void window_stress_report(WindowSim* sim)
 {
-	fprintf(stderr, "Error: %d: %s\n", error, description);
+	size_t frames = static_cast<size_t>(sim->render_frames.exchange(0, std::memory_order_relaxed));
+	size_t sprites = static_cast<size_t>(sim->render_sprites.exchange(0, std::memory_order_relaxed));
+	std::chrono::nanoseconds render_time{ sim->render_ns.exchange(0, std::memory_order_relaxed) };
+	stress_report(*sim->game, sim->stress_ticks, sim->stress_entity_ticks, sim->stress_sim_time,
+		frames, sprites, render_time);
+	sim->stress_ticks = 0;
+	sim->stress_entity_ticks = 0;
+	sim->stress_sim_time = sim->stress_sim_time.zero();
 }
 
-void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+// Runs a tick and publishes what it looks like to the render queue.
+// Returns false once the game should stop.
+bool window_step(WindowSim* sim)
 {
-	switch (key)
+	Game* game = sim->game;
+	size_t num_entities = game->aliens->count + game->bullets->count;
+
+	auto sim_start = std::chrono::steady_clock::now();
+	bool running = window_tick(sim);
+	RenderState* state = render_queue_back(sim->render_queue);
+	render_state_capture(state, *game);
+	if (LatencyTracker* latency = sim->latency)
+	{
+		if (latency->tagged_press <= latency->shown_press.load(std::memory_order_acquire)) latency->tagged_time = 0;
+		state->input_time = latency->tagged_time;
+		state->input_press = latency->tagged_press;
+	}
+	render_queue_publish(sim->render_queue);
+	auto sim_end = std::chrono::steady_clock::now();
+
+	if (running && sim->options->stress)
+	{
+		++sim->stress_ticks;
+		sim->stress_entity_ticks += num_entities;
+		sim->stress_sim_time += sim_end - sim_start;
+		if (sim->stress_ticks == STRESS_REPORT_TICKS) window_stress_report(sim);
+	}
+	return running;
+}
+
+// Ticks at TICKS_PER_SECOND, or flat out with --unlimited, until the game
+// ends or the window closes. Vsync only ever blocks the render thread.
+void window_simulate(WindowSim* sim)
+{
+	const std::chrono::nanoseconds tick_duration{ 1000000000 / TICKS_PER_SECOND };
+	// Late ticks catch up until they fall this far behind, then the
+	// schedule starts over from now instead of running a burst
+	const std::chrono::nanoseconds max_lag = 4 * tick_duration;
+	auto next_tick = std::chrono::steady_clock::now();
+
+	while (game_running.load(std::memory_order_acquire) && window_step(sim))
 	{
-	case GLFW_KEY_ESCAPE:
-		if (action == GLFW_PRESS) game_running = false;
-		break;
-	case GLFW_KEY_RIGHT:
-		if (action == GLFW_PRESS) move_dir += 1;
-		else if (action == GLFW_RELEASE) move_dir -= 1;
-		break;
-	case GLFW_KEY_LEFT:
-		if (action == GLFW_PRESS) move_dir -= 1;
-		else if (action == GLFW_RELEASE) move_dir += 1;
-		break;
-	case GLFW_KEY_SPACE:
-		if (action == GLFW_PRESS) fire_pressed = true;
-		break;
-	default:
-		break;
+		if (!sim->options->unlimited)
+		{
+			auto now = std::chrono::steady_clock::now();
+			next_tick += tick_duration;
+			if (now - next_tick > max_lag) next_tick = now;
+			std::this_thread::sleep_until(next_tick);
+		}
 	}
+
+	game_running.store(false, std::memory_order_release);
 }
 
-int main()
+int run_window(
+	Game* game, const Options& options,
+	Replay* replay, Replay* recording, Rewind* rewind
+)
 {
 	GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun);
 	glfwSetErrorCallback(error_callback);
@@ -225,11 +503,14 @@ int main()
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	auto gl_start = std::chrono::steady_clock::now();
+	if (!gl_init(reinterpret_cast<GLLoadProc>(glfwGetProcAddress)))
 	{
-		printf("Failed to initialize GLAD\n");
+		printf("Failed to load OpenGL\n");
 		return -1;
 	}
+	std::chrono::duration<double, std::micro> gl_time = std::chrono::steady_clock::now() - gl_start;
+	printf("OpenGL loader ready in %.1f us\n", gl_time.count());
 
 	int glVersion[2] = { -1, 1 };
 	glGetIntegerv(GL_MAJOR_VERSION, &glVersion[0]);
@@ -250,7 +531,10 @@ int main()
 	glGenVertexArrays(1, &fullscreen_triangle_vao);
 	glBindVertexArray(fullscreen_triangle_vao);
 
-	OurShader ourShader("shader.vs.glsl", "shader.fs.glsl");
+	auto shader_start = std::chrono::steady_clock::now();
+	OurShader ourShader(SCREEN_VERTEX_SHADER, SCREEN_FRAGMENT_SHADER, options.shader_cache_path);
+	std::chrono::duration<double, std::milli> shader_time = std::chrono::steady_clock::now() - shader_start;
+	printf("Shaders %s in %.2f ms\n", ourShader.cached ? "loaded from cache" : "compiled", shader_time.count());
 
 	GLuint buffer_texture;
 	glGenTextures(1, &buffer_texture);
@@ -272,460 +556,274 @@ int main()
 	// OpenGL setup
 	glDisable(GL_DEPTH_TEST);
 	glActiveTexture(GL_TEXTURE0);
-	glfwSwapInterval(1);
+	glfwSwapInterval(options.unlimited ? 0 : 1);
 
 	glBindVertexArray(fullscreen_triangle_vao);
 
-	// Alien sprite
-	const size_t ALIEN_SPRITES_MAX = 6;
-	Sprite alien_sprites[ALIEN_SPRITES_MAX];
-
-	alien_sprites[0].width = 8;
-	alien_sprites[0].height = 8;
-	alien_sprites[0].data = new uint8_t[64]
-	{
-		0,0,0,1,1,0,0,0, // ...@@...
-		0,0,1,1,1,1,0,0, // ..@@@@..
-		0,1,1,1,1,1,1,0, // .@@@@@@.
-		1,1,0,1,1,0,1,1, // @@.@@.@@
-		1,1,1,1,1,1,1,1, // @@@@@@@@
-		0,1,0,1,1,0,1,0, // .@.@@.@.
-		1,0,0,0,0,0,0,1, // @......@
-		0,1,0,0,0,0,1,0  // .@....@.
-	};
-
-	alien_sprites[1].width = 8;
-	alien_sprites[1].height = 8;
-	alien_sprites[1].data = new uint8_t[64]
-	{
-		0,0,0,1,1,0,0,0, // ...@@...
-		0,0,1,1,1,1,0,0, // ..@@@@..
-		0,1,1,1,1,1,1,0, // .@@@@@@.
-		1,1,0,1,1,0,1,1, // @@.@@.@@
-		1,1,1,1,1,1,1,1, // @@@@@@@@
-		0,0,1,0,0,1,0,0, // ..@..@..
-		0,1,0,1,1,0,1,0, // .@.@@.@.
-		1,0,1,0,0,1,0,1  // @.@..@.@
-	};
-
-	alien_sprites[2].width = 11;
-	alien_sprites[2].height = 8;
-	alien_sprites[2].data = new uint8_t[88]
-	{
-		0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-		0,0,0,1,0,0,0,1,0,0,0, // ...@...@...
-		0,0,1,1,1,1,1,1,1,0,0, // ..@@@@@@@..
-		0,1,1,0,1,1,1,0,1,1,0, // .@@.@@@.@@.
-		1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-		1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
-		1,0,1,0,0,0,0,0,1,0,1, // @.@.....@.@
-		0,0,0,1,1,0,1,1,0,0,0  // ...@@.@@...
-	};
-
-	alien_sprites[3].width = 11;
-	alien_sprites[3].height = 8;
-	alien_sprites[3].data = new uint8_t[88]
-	{
-		0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-		1,0,0,1,0,0,0,1,0,0,1, // @..@...@..@
-		1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
-		1,1,1,0,1,1,1,0,1,1,1, // @@@.@@@.@@@
-		1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-		0,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@.
-		0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-		0,1,0,0,0,0,0,0,0,1,0  // .@.......@.
-	};
-
-	alien_sprites[4].width = 12;
-	alien_sprites[4].height = 8;
-	alien_sprites[4].data = new uint8_t[96]
-	{
-		0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
-		0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
-		1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-		1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
-		1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-		0,0,0,1,1,0,0,1,1,0,0,0, // ...@@..@@...
-		0,0,1,1,0,1,1,0,1,1,0,0, // ..@@.@@.@@..
-		1,1,0,0,0,0,0,0,0,0,1,1  // @@........@@
-	};
-
-
-	alien_sprites[5].width = 12;
-	alien_sprites[5].height = 8;
-	alien_sprites[5].data = new uint8_t[96]
-	{
-		0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
-		0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
-		1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-		1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
-		1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-		0,0,1,1,1,0,0,1,1,1,0,0, // ..@@@..@@@..
-		0,1,1,0,0,1,1,0,0,1,1,0, // .@@..@@..@@.
-		0,0,1,1,0,0,0,0,1,1,0,0  // ..@@....@@..
-	};
-
-	Sprite alien_death_sprite;
-	alien_death_sprite.width = 13;
-	alien_death_sprite.height = 7;
-	alien_death_sprite.data = new uint8_t[91]
-	{
-		0,1,0,0,1,0,0,0,1,0,0,1,0, // .@..@...@..@.
-		0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
-		0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
-		1,1,0,0,0,0,0,0,0,0,0,1,1, // @@.........@@
-		0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
-		0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
-		0,1,0,0,1,0,0,0,1,0,0,1,0  // .@..@...@..@.
-	};
-
-	const size_t ALIEN_ANIMATION_MAX = 3;
-	SpriteAnimation alien_animation[ALIEN_ANIMATION_MAX];
-
-	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
-	{
-		alien_animation[i].loop = true;
-		alien_animation[i].num_frames = 2;
-		alien_animation[i].frame_duration = 10;
-		alien_animation[i].time = 0;
-
-		alien_animation[i].frames = new Sprite * [2];
-		alien_animation[i].frames[0] = &alien_sprites[2 * i];
-		alien_animation[i].frames[1] = &alien_sprites[2 * i + 1];
-
-	}
-
-
-
-	// Player sprite
-	Sprite player_sprite;
-	player_sprite.width = 11;
-	player_sprite.height = 7;
-	player_sprite.data = new uint8_t[77]
-	{
-		0,0,0,0,0,1,0,0,0,0,0, // .....@.....
-		0,0,0,0,1,1,1,0,0,0,0, // ....@@@....
-		0,0,0,0,1,1,1,0,0,0,0, // ....@@@....
-		0,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@.
-		1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-		1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-		1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-	};
-
-	// Score sprite
-	Sprite text_spritesheet;
-	text_spritesheet.width = 5;
-	text_spritesheet.height = 7;
-	text_spritesheet.data = new uint8_t[65 * 35]
-	{
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
-		0,1,0,1,0,0,1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,1,0,1,0,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,0,1,0,1,0,
-		0,0,1,0,0,0,1,1,1,0,1,0,1,0,0,0,1,1,1,0,0,0,1,0,1,0,1,1,1,0,0,0,1,0,0,
-		1,1,0,1,0,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,0,1,0,1,1,
-		0,1,1,0,0,1,0,0,1,0,1,0,0,1,0,0,1,1,0,0,1,0,0,1,0,1,0,0,0,1,0,1,1,1,1,
-		0,0,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
-		1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
-		0,0,1,0,0,1,0,1,0,1,0,1,1,1,0,0,0,1,0,0,0,1,1,1,0,1,0,1,0,1,0,0,1,0,0,
-		0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,
-		0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,
-
-		0,1,1,1,0,1,0,0,0,1,1,0,0,1,1,1,0,1,0,1,1,1,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		0,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
-		0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
-		1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,1,0,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		0,0,0,1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,0,1,1,1,1,1,0,0,0,1,0,0,0,0,1,0,
-		1,1,1,1,1,1,0,0,0,0,1,1,1,1,0,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-
-		0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
-		0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
-		0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,
-		1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
-		0,1,1,1,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,1,0,1,1,1,0,1,1,1,0,1,0,0,1,0,0,0,1,0,1,1,1,0,
-
-		0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,
-		1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,1,0,
-		1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
-		1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
-		1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,1,1,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
-		0,1,1,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
-		0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,1,0,0,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
-		1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
-		1,0,0,0,1,1,1,0,1,1,1,0,1,0,1,1,0,1,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
-		1,0,0,0,1,1,0,0,0,1,1,1,0,0,1,1,0,1,0,1,1,0,0,1,1,1,0,0,0,1,1,0,0,0,1,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,0,1,1,0,1,1,1,1,
-		1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
-		0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,1,1,1,0,
-		1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
-		1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-		1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,
-		1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,1,0,1,1,1,0,1,1,1,0,0,0,1,
-		1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,
-		1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
-		1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
-
-		0,0,0,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,1,
-		0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,
-		1,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,0,
-		0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,
-		0,0,1,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
-	};
-
-	Sprite number_spritesheet = text_spritesheet;
-	number_spritesheet.data += 16 * 35;
-
-	// Bullet sprite
-	Sprite bullet_sprite;
-	bullet_sprite.width = 1;
-	bullet_sprite.height = 3;
-	bullet_sprite.data = new uint8_t[3]
-	{
-		1, // @
-		1, // @
-		1  // @
-	};
-
-
-	Game game;
-	game.width = BUFFER_WIDTH;
-	game.height = BUFFER_HEIGHT;
-	game.num_aliens = 55;
-	game.num_bullets = GAME_MAX_BULLETS;
-	game.aliens = new Alien[game.num_aliens];
+	RandomInput random_input;
+	random_input_init(&random_input, options.game.seed, 0);
+	RandomInput* bot = options.input == INPUT_RANDOM ? &random_input : nullptr;
+
+	// Starts out with the current tick so there is a frame to show
+	RenderQueue render_queue;
+	render_queue_init(&render_queue, game_entity_capacity(game->config));
+	render_state_capture(render_queue_back(&render_queue), *game);
+	render_queue_publish(&render_queue);
+
+	WindowSim sim;
+	sim.game = game;
+	sim.options = &options;
+	sim.replay = replay;
+	sim.recording = recording;
+	sim.rewind = rewind;
+	sim.bot = bot;
+	sim.render_queue = &render_queue;
+	sim.latency = nullptr;
+	sim.stress_ticks = 0;
+	sim.stress_entity_ticks = 0;
+	sim.stress_sim_time = sim.stress_sim_time.zero();
+	sim.render_frames = 0;
+	sim.render_sprites = 0;
+	sim.render_ns = 0;
+
+	LatencyTracker latency;
+	if (options.latency)
+	{
+		latency_init(&latency.to_tick);
+		latency_init(&latency.to_photon);
+		latency.tagged_time = 0;
+		latency.tagged_press = 0;
+		latency.shown_press = 0;
+		sim.latency = &latency;
+	}
 
-	game.player.x = (BUFFER_WIDTH / 2) - (player_sprite.width / 2);
-	game.player.y = 32;
+	// The game belongs to the simulation thread from here until it is
+	// joined. It also submits the collision jobs in place of this thread.
+	// With --low-latency there is no simulation thread: every frame polls,
+	// ticks, draws and swaps in that order, so input is on screen one swap
+	// after it was sampled.
+	input_queue_init(&input_queue);
+	game_running = true;
+	std::thread simulation;
+	if (!options.low_latency) simulation = std::thread(window_simulate, &sim);
 
-	game.player.life = 3;
+	// The state on screen, kept by the render queue until the next acquire
+	const RenderState* shown = nullptr;
+	const std::chrono::microseconds frame_delay{ options.frame_delay };
+	auto swapped = std::chrono::steady_clock::now();
 
-	// Set alien positions and types
-	for (size_t yi = 0; yi < 5; yi++)
+	while (!glfwWindowShouldClose(window) && game_running.load(std::memory_order_acquire))
 	{
-		for (size_t xi = 0; xi < 11; xi++)
+		if (options.low_latency)
 		{
-			Alien& alien = game.aliens[yi * 11 + xi];
-			alien.type = static_cast<AlienType>((5 - yi) / 2 + 1);
+			// Sleep through the start of the frame so input is sampled as
+			// close to the next vblank as the tick and the draw allow
+			if (frame_delay.count()) std::this_thread::sleep_until(swapped + frame_delay);
+			glfwPollEvents();
+			if (!window_step(&sim)) break;
+		}
+		else
+		{
+			glfwPollEvents();
+		}
 
-			const Sprite& sprite = alien_sprites[2 * (alien.type - 1)];
+		// Redraw only when a new tick came in, otherwise show the last one
+		if (const RenderState* state = render_queue_acquire(&render_queue))
+		{
+			shown = state;
 
-			alien.x = 16 * xi + 20 + (alien_death_sprite.width - sprite.width) / 2;
-			alien.y = 17 * yi + 128;
+			auto render_start = std::chrono::steady_clock::now();
+			render_state_draw(*state, &buffer, clear_color);
+			auto render_end = std::chrono::steady_clock::now();
+
+			sim.render_frames.fetch_add(1, std::memory_order_relaxed);
+			sim.render_sprites.fetch_add(state->num_draws, std::memory_order_relaxed);
+			sim.render_ns.fetch_add((render_end - render_start).count(), std::memory_order_relaxed);
+
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLint>(buffer.width),
+				static_cast<GLint>(buffer.height), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, buffer.data);
 		}
-	}
 
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
-	// Initialize death counter for aliens
-	uint8_t* death_counters = new uint8_t[game.num_aliens];
-	for (size_t i = 0; i < game.num_aliens; i++)
-	{
-		death_counters[i] = 10;
+		glfwSwapBuffers(window);
+		swapped = std::chrono::steady_clock::now();
+
+		if (sim.latency && shown && shown->input_time &&
+			shown->input_press > latency.shown_press.load(std::memory_order_relaxed))
+		{
+			latency_record(&latency.to_photon, input_time_now() - shown->input_time);
+			latency.shown_press.store(shown->input_press, std::memory_order_release);
+		}
 	}
 
-	game_running = true;
+	game_running.store(false, std::memory_order_release);
+	if (simulation.joinable()) simulation.join();
+
+	if (options.stress && sim.stress_ticks) window_stress_report(&sim);
+
+	glDeleteVertexArrays(1, &fullscreen_triangle_vao);
 
+	printf("OpenGL: resolved %zu entry points in %.1f us\n", gl_resolved_count(), gl_resolve_nanoseconds() / 1000.0);
 
-	while (!glfwWindowShouldClose(window) && game_running)
+	glfwDestroyWindow(window);
+	glfwTerminate();
+
+	if (sim.latency)
 	{
-		buffer_clear(&buffer, clear_color);
+		latency_report(latency.to_tick, "Input to tick");
+		latency_report(latency.to_photon, "Input to photon");
+	}
 
-		// Draw
-		// SCORE
-		buffer_draw_text(&buffer, text_spritesheet, "SCORE",
-			4, game.height - text_spritesheet.height - 7,
-			rgb_to_uint32(128, 0, 0)
-		);
+	render_queue_free(&render_queue);
+	delete[] buffer.data;
 
-		buffer_draw_number(&buffer, number_spritesheet, score,
-			4 + 2 * number_spritesheet.width, game.height - 2 * number_spritesheet.height - 12,
-			rgb_to_uint32(128, 0, 0)
-		);
+	return 0;
+}
 
-		for (size_t i = 0; i < game.width; ++i)
-		{
-			buffer.data[game.width * 16 + i] = rgb_to_uint32(128, 0, 0);
-		}
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!options_parse(&options, argc, argv))
+	{
+		return -1;
+	}
 
-		buffer_draw_text(
-			&buffer,
-			text_spritesheet, "CREDIT 00",
-			164, 7,
-			rgb_to_uint32(128, 0, 0)
-		);
+	if (options.write_atlas_path)
+	{
+		return atlas_save(SPRITES, options.write_atlas_path) ? 0 : -1;
+	}
 
-		for (size_t ai = 0; ai < game.num_aliens; ai++)
+	// Sprites from the atlas point straight into its mapping
+	Sprites sprites = SPRITES;
+	MappedFile atlas = {};
+	if (options.atlas_path)
+	{
+		if (!file_map(&atlas, options.atlas_path) || !atlas_load(&sprites, atlas.data, atlas.size))
 		{
-			if (!death_counters[ai]) continue;
-
-			const Alien& alien = game.aliens[ai];
-			if (alien.type == ALIEN_DEAD)
-			{
-				buffer_draw_sprite(&buffer, alien_death_sprite,
-					alien.x, alien.y, rgb_to_uint32(128, 0, 0));
-			}
-			else
-			{
-				const SpriteAnimation& animation = alien_animation[alien.type - 1];
-				size_t current_frame = animation.time / animation.frame_duration;
-				const Sprite& sprite = *animation.frames[current_frame];
-				buffer_draw_sprite(&buffer, sprite,
-					alien.x, alien.y, rgb_to_uint32(128, 0, 0));
-			}
+			fprintf(stderr, "Invalid sprite atlas %s\n", options.atlas_path);
+			file_unmap(&atlas);
+			return -1;
 		}
+	}
 
-		// Draw bullet
-		for (size_t bi = 0; bi < game.num_bullets; bi++)
+	Replay replay;
+	if (options.replay_path)
+	{
+		if (!replay_load(&replay, options.replay_path))
 		{
-			const Bullet& bullet = game.bullets[bi];
-			const Sprite& sprite = bullet_sprite;
-			buffer_draw_sprite(&buffer, sprite,
-				bullet.x, bullet.y, rgb_to_uint32(128, 0, 0));
+			return -1;
 		}
+		options.game = replay.config;
+	}
 
-		buffer_draw_sprite(&buffer, player_sprite,
-			game.player.x, game.player.y, rgb_to_uint32(128, 0, 0));
-
+	Replay recording;
+	if (options.record_path)
+	{
+		replay_init(&recording, options.game);
+	}
 
-		// Update animation
-		for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	// Resume where the last run left off. The snapshot is used straight
+	// from the mapping.
+	MappedFile snapshot = {};
+	if (options.snapshot_path && file_map(&snapshot, options.snapshot_path))
+	{
+		if (!snapshot_config(snapshot.data, snapshot.size, &options.game))
 		{
-			++alien_animation[i].time;
-			if (alien_animation[i].time == alien_animation[i].num_frames * alien_animation[i].frame_duration)
-			{
-				alien_animation[i].time = 0;
-			}
+			fprintf(stderr, "Ignoring invalid snapshot %s\n", options.snapshot_path);
+			file_unmap(&snapshot);
 		}
+	}
 
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLint>(buffer.width),
-			static_cast<GLint>(buffer.height), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, buffer.data);
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
-		glfwSwapBuffers(window);
+	Game game;
+	game_init(&game, options.game, &sprites, BUFFER_WIDTH, BUFFER_HEIGHT);
 
-		// Simulate Alien
-		for (size_t ai = 0; ai < game.num_aliens; ai++)
+	if (snapshot.data)
+	{
+		if (snapshot_restore(&game, snapshot.data, snapshot.size))
 		{
-			const Alien& alien = game.aliens[ai];
-			if (alien.type == ALIEN_DEAD && death_counters[ai] != 0)
-			{
-				--death_counters[ai];
-			}
-
+			printf("Resumed from %s at tick %llu\n", options.snapshot_path, static_cast<unsigned long long>(game.tick));
 		}
-
-		// Simulate bullets
-		for (size_t bi = 0; bi < game.num_bullets; bi++)
+		else
 		{
-			game.bullets[bi].y += game.bullets[bi].dir;
-			if (game.bullets[bi].y >= game.height ||
-				game.bullets[bi].y < bullet_sprite.height)
-			{
-				game.bullets[bi] = game.bullets[game.num_bullets - 1];
-				--game.num_bullets;
-				continue;
-			}
+			fprintf(stderr, "Ignoring invalid snapshot %s\n", options.snapshot_path);
+		}
+		file_unmap(&snapshot);
+	}
 
-			// Check hit
-			for (size_t ai = 0; ai < game.num_aliens; ai++)
-			{
-				const Alien& alien = game.aliens[ai];
-				if (alien.type == ALIEN_DEAD) continue;
-
-				const SpriteAnimation& animation = alien_animation[alien.type - 1];
-				size_t current_frame = animation.time / animation.frame_duration;
-				const Sprite& alien_sprite = *animation.frames[current_frame];
-				bool overlap = sprite_overlap_check(
-					bullet_sprite, game.bullets[bi].x, game.bullets[bi].y,
-					alien_sprite, game.aliens[ai].x, game.aliens[ai].y
-				);
-
-				if (overlap)
-				{
-					game.aliens[ai].type = ALIEN_DEAD;
-					// NOTE: Hack to recenter death sprite
-					game.aliens[ai].x -= (alien_death_sprite.width - alien_sprite.width) / 2;
-					game.bullets[bi] = game.bullets[game.num_bullets - 1];
-					--game.num_bullets;
-					score += 10 * (4 - game.aliens[ai].type);
-					continue;
-				}
-			}
+	JobSystem jobs;
+	if (options.num_threads > 1)
+	{
+		jobs_init(&jobs, options.num_threads);
+		game.jobs = &jobs;
+	}
 
-			++bi;
-		}
+	Rewind rewind;
+	Rewind* history = nullptr;
+	if (options.rewind_seconds && !options.headless)
+	{
+		size_t ticks = options.rewind_seconds * TICKS_PER_SECOND;
+		rewind_init(&rewind, ticks, rewind_capacity(game, ticks));
+		rewind_record(&rewind, game);
+		history = &rewind;
+	}
 
-		// Simulate player
-		// Input
-		player_move_dir = 2 * move_dir;
-		if (player_move_dir != 0)
+	Replay* input_replay = options.replay_path ? &replay : nullptr;
+	Replay* output_replay = options.record_path ? &recording : nullptr;
+	int result = options.batch ?
+		run_batch(sprites, options, game.jobs) :
+		options.headless ?
+		run_headless(&game, sprites, options, input_replay, output_replay) :
+		run_window(&game, options, input_replay, output_replay, history);
+
+	if (input_replay)
+	{
+		// A replay played to the end has to land on the recorded state
+		if (replay.run == replay.num_runs)
 		{
-			if (game.player.x + player_sprite.width + player_move_dir >= game.width)
-			{
-				game.player.x = game.width - player_sprite.width;
-			}
-			else if (static_cast<int>(game.player.x) + player_move_dir <= 0)
+			uint64_t checksum = game_checksum(game);
+			if (checksum == replay.checksum)
 			{
-				game.player.x = 0;
+				printf("Replay verified after %llu ticks\n", static_cast<unsigned long long>(game.tick));
 			}
 			else
 			{
-				game.player.x += player_move_dir;
+				fprintf(stderr, "Replay diverged: checksum %016llx, recorded %016llx\n",
+					static_cast<unsigned long long>(checksum), static_cast<unsigned long long>(replay.checksum));
+				result = -1;
 			}
 		}
+		replay_free(&replay);
+	}
 
+	if (options.snapshot_path && !snapshot_save(game, options.snapshot_path))
+	{
+		result = -1;
+	}
 
-		// Fire
-		if (fire_pressed && game.num_bullets < GAME_MAX_BULLETS)
+	if (output_replay)
+	{
+		recording.checksum = game_checksum(game);
+		if (!replay_save(&recording, options.record_path))
 		{
-			game.bullets[game.num_bullets].x = game.player.x + player_sprite.width / 2;
-			game.bullets[game.num_bullets].y = game.player.y + player_sprite.height;
-			game.bullets[game.num_bullets].dir = 2;
-			++game.num_bullets;
+			result = -1;
 		}
-		fire_pressed = false;
-
-
-		glfwPollEvents();
+		replay_free(&recording);
 	}
 
-	glfwDestroyWindow(window);
-	glfwTerminate();
-
-	glDeleteVertexArrays(1, &fullscreen_triangle_vao);
-	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	if (history)
 	{
-		delete[] alien_animation[i].frames;
+		rewind_free(&rewind);
 	}
 
-	delete alien_death_sprite.data;
-
-	for (size_t i = 0; i < ALIEN_SPRITES_MAX; i++)
+	if (game.jobs)
 	{
-		delete[] alien_sprites[i].data;
+		jobs_free(&jobs);
 	}
 
-	delete[] buffer.data;
-	delete[] game.aliens;
-	delete[] death_counters;
-
+	game_free(&game);
+	file_unmap(&atlas);
 
-	return 0;
-}
\ No newline at end of file
+	return result;
+}
@@ -0,0 +1,238 @@
+#include "Observation.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OBSERVATION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// BT.601 luma weights in 8.8 fixed point, summing to 256 so white stays 255
+static const uint32_t LUMA_R = 77;
+static const uint32_t LUMA_G = 150;
+static const uint32_t LUMA_B = 29;
+
+// Column sums are 16 bits, enough for this many rows of 255
+static const uint32_t OBSERVATION_MAX_BLOCK_ROWS = 257;
+
+// Averages multiply the rounded block sum n by 2^48 / size rounded up,
+// which gives n / size exactly while n times the rounding, under size,
+// stays below 2^48. Blocks hold at most OBSERVATION_MAX_SOURCE_WIDTH x 257
+// = 263,168 pixels and n < 256 * size, so that is under 2^45, and the
+// product itself stays under 2^57.
+static const uint32_t RECIPROCAL_SHIFT = 48;
+
+static inline uint16_t pixel_luma(uint32_t pixel)
+{
+	uint32_t r = pixel >> 24;
+	uint32_t g = (pixel >> 16) & 0xFF;
+	uint32_t b = (pixel >> 8) & 0xFF;
+	return static_cast<uint16_t>((LUMA_R * r + LUMA_G * g + LUMA_B * b) >> 8);
+}
+
+// Splits count source pixels over n outputs, index 0 first. Blocks never
+// come out empty, so upsampling repeats pixels.
+static void observer_spans(
+	uint32_t* begin, uint32_t* end, size_t n, size_t count, Pooling pooling
+)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		size_t first, last;
+		if (pooling == POOLING_NEAREST)
+		{
+			first = (2 * i + 1) * count / (2 * n);
+			last = first + 1;
+		}
+		else
+		{
+			first = i * count / n;
+			last = (i + 1) * count / n;
+			if (last == first) ++last;
+		}
+
+		begin[i] = static_cast<uint32_t>(first);
+		end[i] = static_cast<uint32_t>(last);
+	}
+}
+
+bool observer_init(
+	Observer* observer, size_t width, size_t height, Pooling pooling,
+	size_t source_width, size_t source_height
+)
+{
+	if (!width || !height || !source_width || !source_height) return false;
+	if (source_width > OBSERVATION_MAX_SOURCE_WIDTH || pooling >= POOLING_COUNT) return false;
+
+	observer->width = width;
+	observer->height = height;
+	observer->pooling = pooling;
+	observer->source_width = source_width;
+	observer->source_height = source_height;
+
+	observer->column_begin = new uint32_t[width];
+	observer->column_end = new uint32_t[width];
+	observer->row_begin = new uint32_t[height];
+	observer->row_end = new uint32_t[height];
+
+	observer_spans(observer->column_begin, observer->column_end, width, source_width, pooling);
+
+	// Rows are split top down, but the buffer stores the bottom row first
+	observer_spans(observer->row_begin, observer->row_end, height, source_height, pooling);
+	for (size_t y = 0; y < height; y++)
+	{
+		if (observer->row_end[y] - observer->row_begin[y] > OBSERVATION_MAX_BLOCK_ROWS)
+		{
+			observer_free(observer);
+			return false;
+		}
+
+		uint32_t first = observer->row_begin[y];
+		observer->row_begin[y] = static_cast<uint32_t>(source_height) - observer->row_end[y];
+		observer->row_end[y] = static_cast<uint32_t>(source_height) - first;
+	}
+
+	observer->min_block_columns = observer->column_end[0] - observer->column_begin[0];
+	for (size_t x = 1; x < width; x++)
+	{
+		uint32_t columns = observer->column_end[x] - observer->column_begin[x];
+		if (columns < observer->min_block_columns) observer->min_block_columns = columns;
+	}
+	observer->min_block_rows = observer->row_end[0] - observer->row_begin[0];
+	for (size_t y = 1; y < height; y++)
+	{
+		uint32_t rows = observer->row_end[y] - observer->row_begin[y];
+		if (rows < observer->min_block_rows) observer->min_block_rows = rows;
+	}
+
+	for (uint32_t r = 0; r < 2; r++)
+	{
+		for (uint32_t c = 0; c < 2; c++)
+		{
+			uint64_t size = static_cast<uint64_t>(observer->min_block_rows + r) * (observer->min_block_columns + c);
+			observer->reciprocals[r][c] = ((uint64_t(1) << RECIPROCAL_SHIFT) + size - 1) / size;
+		}
+	}
+
+	return true;
+}
+
+void observer_free(Observer* observer)
+{
+	delete[] observer->column_begin;
+	delete[] observer->column_end;
+	delete[] observer->row_begin;
+	delete[] observer->row_end;
+	*observer = {};
+}
+
+#ifdef OBSERVATION_SSE2
+
+static inline __m128i luma4(__m128i pixels)
+{
+	const __m128i byte = _mm_set1_epi32(0xFF);
+	__m128i r = _mm_srli_epi32(pixels, 24);
+	__m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 16), byte);
+	__m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 8), byte);
+
+	// r and g share a 32-bit lane as two 16-bit halves, so one madd weighs both
+	__m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+	__m128i luma = _mm_add_epi32(
+		_mm_madd_epi16(rg, _mm_set1_epi32(static_cast<int>(LUMA_R | (LUMA_G << 16)))),
+		_mm_madd_epi16(b, _mm_set1_epi32(static_cast<int>(LUMA_B))));
+	return _mm_srli_epi32(luma, 8);
+}
+
+#endif
+
+// Folds one source row into the per-column accumulator: the first row of
+// a block initializes it, later rows add or take the maximum
+static void accumulate_row(
+	uint16_t* accumulator, const uint32_t* row, size_t width, bool first, bool max
+)
+{
+	size_t x = 0;
+#ifdef OBSERVATION_SSE2
+	for (; x + 8 <= width; x += 8)
+	{
+		__m128i a = luma4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x)));
+		__m128i b = luma4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x + 4)));
+		__m128i luma = _mm_packs_epi32(a, b);
+
+		__m128i* out = reinterpret_cast<__m128i*>(accumulator + x);
+		if (!first)
+		{
+			__m128i current = _mm_loadu_si128(out);
+			luma = max ? _mm_max_epi16(current, luma) : _mm_add_epi16(current, luma);
+		}
+		_mm_storeu_si128(out, luma);
+	}
+#endif
+	for (; x < width; x++)
+	{
+		uint16_t luma = pixel_luma(row[x]);
+		if (first) accumulator[x] = luma;
+		else if (max) accumulator[x] = luma > accumulator[x] ? luma : accumulator[x];
+		else accumulator[x] = static_cast<uint16_t>(accumulator[x] + luma);
+	}
+}
+
+void observe_buffer(const Observer* observer, const Buffer& buffer, uint8_t* pixels)
+{
+	uint16_t accumulator[OBSERVATION_MAX_SOURCE_WIDTH];
+	bool max = observer->pooling == POOLING_MAX;
+
+	// Locals, since stores through the byte output may alias the observer
+	const uint32_t* column_begin = observer->column_begin;
+	const uint32_t* column_end = observer->column_end;
+	size_t width = observer->width;
+	uint32_t min_block_columns = observer->min_block_columns;
+
+	for (size_t y = 0; y < observer->height; y++)
+	{
+		uint32_t row_begin = observer->row_begin[y];
+		uint32_t row_end = observer->row_end[y];
+		for (uint32_t sy = row_begin; sy < row_end; sy++)
+		{
+			accumulate_row(accumulator, buffer.data + sy * buffer.width, observer->source_width,
+				sy == row_begin, max);
+		}
+
+		uint8_t* out = pixels + y * width;
+		if (observer->pooling == POOLING_NEAREST)
+		{
+			for (size_t x = 0; x < width; x++)
+			{
+				out[x] = static_cast<uint8_t>(accumulator[column_begin[x]]);
+			}
+			continue;
+		}
+
+		if (max)
+		{
+			for (size_t x = 0; x < width; x++)
+			{
+				uint16_t value = 0;
+				for (uint32_t sx = column_begin[x]; sx < column_end[x]; sx++)
+				{
+					value = accumulator[sx] > value ? accumulator[sx] : value;
+				}
+				out[x] = static_cast<uint8_t>(value);
+			}
+			continue;
+		}
+
+		uint32_t block_rows = row_end - row_begin;
+		const uint64_t* reciprocals = observer->reciprocals[block_rows - observer->min_block_rows];
+		for (size_t x = 0; x < width; x++)
+		{
+			uint32_t sum = 0;
+			for (uint32_t sx = column_begin[x]; sx < column_end[x]; sx++)
+			{
+				sum += accumulator[sx];
+			}
+
+			uint32_t block_columns = column_end[x] - column_begin[x];
+			uint64_t rounded = sum + block_rows * block_columns / 2;
+			out[x] = static_cast<uint8_t>((rounded * reciprocals[block_columns - min_block_columns]) >> RECIPROCAL_SHIFT);
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Buffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Downsampled grayscale observations for agents. Each output pixel covers
+// a block of source pixels, which are converted to luminance and pooled
+// in one pass over the frame, eight pixels at a time where SSE2 is
+// available. Output rows run from the top of the screen down, one byte
+// per pixel.
+
+const size_t OBSERVATION_MAX_SOURCE_WIDTH = 1024;
+
+enum Pooling
+{
+	POOLING_NEAREST, // Pixel at the center of the block
+	POOLING_AVERAGE,
+	POOLING_MAX,
+	POOLING_COUNT
+};
+
+struct Observer
+{
+	size_t width, height;
+	Pooling pooling;
+	size_t source_width, source_height;
+
+	// Source block [begin, end) of every output column and row, rows in
+	// buffer order
+	uint32_t* column_begin;
+	uint32_t* column_end;
+	uint32_t* row_begin;
+	uint32_t* row_end;
+
+	// Blocks are min_block_columns or one more wide and likewise tall.
+	// Averages divide by multiplying with the reciprocal for each shape.
+	uint32_t min_block_columns, min_block_rows;
+	uint64_t reciprocals[2][2];
+};
+
+// Returns false if a size is zero, source_width is over
+// OBSERVATION_MAX_SOURCE_WIDTH or an output row covers over 257 source rows
+bool observer_init(
+	Observer* observer, size_t width, size_t height, Pooling pooling,
+	size_t source_width, size_t source_height
+);
+void observer_free(Observer* observer);
+
+// Writes width * height bytes to pixels. buffer must be source_width x
+// source_height. Safe to call from several threads at once.
+void observe_buffer(const Observer* observer, const Buffer& buffer, uint8_t* pixels);
@@ -0,0 +1,341 @@
+#include "Options.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static void options_usage(const char* program)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  --stress              report simulation and render cost per entity\n"
+		"  --aliens N            number of aliens\n"
+		"  --formation CxR       alien formation columns and rows (default 11x5)\n"
+		"  --bullets N           bullet capacity (default %zu)\n"
+		"  --fire-rate N         bullets auto-fired per tick (default 0)\n"
+		"  --seed N              random seed for the simulation (default 1)\n"
+		"  --ticks N             quit after N ticks\n"
+		"  --threads N           worker threads including the main one (default: all cores)\n"
+		"  --record FILE         record the input to FILE\n"
+		"  --replay FILE         play back the input recorded in FILE\n"
+		"  --snapshot FILE       resume from FILE and keep saving the game to it\n"
+		"  --atlas FILE          load the sprites from the atlas FILE\n"
+		"  --write-atlas FILE    write the built-in sprites to the atlas FILE and exit\n"
+		"  --shader-cache FILE   keep compiled shader programs in FILE (default shader.cache)\n"
+		"  --no-shader-cache     compile the shaders on every launch\n"
+		"  --rewind N            keep N seconds of history, hold backspace to rewind\n"
+		"  --headless            simulate without a window at full speed\n"
+		"  --games N             run N independent games in parallel when headless\n"
+		"  --render              render every tick when headless\n"
+		"  --batch               step the games in lockstep through the batch API\n"
+		"  --episode-ticks N     end batch episodes after N ticks (default: when cleared)\n"
+		"  --observe WxH         pooled grayscale batch observations of W by H pixels\n"
+		"  --pooling MODE        nearest, average (default) or max for --observe\n"
+		"  --input MODE          player (default) or random\n"
+		"  --unlimited           do not wait for vsync\n"
+		"  --low-latency         sample input, tick, draw and swap on one thread\n"
+		"  --frame-delay US      wait US microseconds after each swap before sampling input\n"
+		"  --latency             measure input-to-photon latency in the window\n",
+		program, GAME_MAX_BULLETS);
+}
+
+static bool parse_uint64(const char* text, uint64_t* value)
+{
+	char* end;
+	unsigned long long parsed = strtoull(text, &end, 10);
+	if (end == text || *end != '\0') return false;
+
+	*value = parsed;
+	return true;
+}
+
+static bool parse_size(const char* text, size_t* value)
+{
+	uint64_t parsed;
+	if (!parse_uint64(text, &parsed)) return false;
+
+	*value = static_cast<size_t>(parsed);
+	return true;
+}
+
+// Parses "AxB" with both sides above zero
+static bool parse_dimensions(const char* text, size_t* a, size_t* b)
+{
+	unsigned long long first, second;
+	char tail;
+	if (sscanf(text, "%llux%llu%c", &first, &second, &tail) != 2 || !first || !second) return false;
+
+	*a = static_cast<size_t>(first);
+	*b = static_cast<size_t>(second);
+	return true;
+}
+
+bool options_parse(Options* options, int argc, char** argv)
+{
+	options->game = game_default_config();
+	options->stress = false;
+	options->max_ticks = 0;
+	options->num_threads = std::thread::hardware_concurrency();
+	if (options->num_threads == 0) options->num_threads = 1;
+	options->record_path = nullptr;
+	options->replay_path = nullptr;
+	options->snapshot_path = nullptr;
+	options->atlas_path = nullptr;
+	options->write_atlas_path = nullptr;
+	options->shader_cache_path = "shader.cache";
+	options->rewind_seconds = 0;
+	options->headless = false;
+	options->num_games = 1;
+	options->render = false;
+	options->batch = false;
+	options->episode_ticks = 0;
+	options->observe_width = 0;
+	options->observe_height = 0;
+	options->pooling = POOLING_AVERAGE;
+	options->input = INPUT_PLAYER;
+	options->unlimited = false;
+	options->low_latency = false;
+	options->frame_delay = 0;
+	options->latency = false;
+
+	size_t num_aliens = 0;
+	bool formation_set = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		bool ok = true;
+		if (strcmp(arg, "--stress") == 0)
+		{
+			options->stress = true;
+			continue;
+		}
+		else if (strcmp(arg, "--headless") == 0)
+		{
+			options->headless = true;
+			continue;
+		}
+		else if (strcmp(arg, "--render") == 0)
+		{
+			options->render = true;
+			continue;
+		}
+		else if (strcmp(arg, "--batch") == 0)
+		{
+			options->batch = true;
+			continue;
+		}
+		else if (strcmp(arg, "--no-shader-cache") == 0)
+		{
+			options->shader_cache_path = nullptr;
+			continue;
+		}
+		else if (strcmp(arg, "--unlimited") == 0)
+		{
+			options->unlimited = true;
+			continue;
+		}
+		else if (strcmp(arg, "--low-latency") == 0)
+		{
+			options->low_latency = true;
+			continue;
+		}
+		else if (strcmp(arg, "--latency") == 0)
+		{
+			options->latency = true;
+			continue;
+		}
+		else if (strcmp(arg, "--aliens") == 0)
+		{
+			ok = value && parse_size(value, &num_aliens) && num_aliens > 0;
+		}
+		else if (strcmp(arg, "--formation") == 0)
+		{
+			ok = value && parse_dimensions(value, &options->game.formation_columns, &options->game.formation_rows);
+			formation_set = true;
+		}
+		else if (strcmp(arg, "--bullets") == 0)
+		{
+			ok = value && parse_size(value, &options->game.max_bullets) && options->game.max_bullets > 0;
+		}
+		else if (strcmp(arg, "--fire-rate") == 0)
+		{
+			ok = value && parse_size(value, &options->game.fire_rate);
+		}
+		else if (strcmp(arg, "--seed") == 0)
+		{
+			ok = value && parse_uint64(value, &options->game.seed);
+		}
+		else if (strcmp(arg, "--ticks") == 0)
+		{
+			ok = value && parse_size(value, &options->max_ticks);
+		}
+		else if (strcmp(arg, "--threads") == 0)
+		{
+			ok = value && parse_size(value, &options->num_threads) && options->num_threads > 0;
+		}
+		else if (strcmp(arg, "--frame-delay") == 0)
+		{
+			ok = value && parse_size(value, &options->frame_delay);
+		}
+		else if (strcmp(arg, "--episode-ticks") == 0)
+		{
+			ok = value && parse_size(value, &options->episode_ticks);
+		}
+		else if (strcmp(arg, "--observe") == 0)
+		{
+			ok = value && parse_dimensions(value, &options->observe_width, &options->observe_height);
+		}
+		else if (strcmp(arg, "--pooling") == 0)
+		{
+			static const char* const POOLING_NAMES[POOLING_COUNT] = { "nearest", "average", "max" };
+			ok = false;
+			for (size_t p = 0; value && p < POOLING_COUNT; p++)
+			{
+				if (strcmp(value, POOLING_NAMES[p]) == 0)
+				{
+					options->pooling = static_cast<Pooling>(p);
+					ok = true;
+				}
+			}
+		}
+		else if (strcmp(arg, "--games") == 0)
+		{
+			ok = value && parse_size(value, &options->num_games) && options->num_games > 0;
+		}
+		else if (strcmp(arg, "--input") == 0)
+		{
+			ok = value && (strcmp(value, "player") == 0 || strcmp(value, "random") == 0);
+			if (ok) options->input = strcmp(value, "random") == 0 ? INPUT_RANDOM : INPUT_PLAYER;
+		}
+		else if (strcmp(arg, "--record") == 0)
+		{
+			ok = value != nullptr;
+			options->record_path = value;
+		}
+		else if (strcmp(arg, "--replay") == 0)
+		{
+			ok = value != nullptr;
+			options->replay_path = value;
+		}
+		else if (strcmp(arg, "--atlas") == 0)
+		{
+			ok = value != nullptr;
+			options->atlas_path = value;
+		}
+		else if (strcmp(arg, "--write-atlas") == 0)
+		{
+			ok = value != nullptr;
+			options->write_atlas_path = value;
+		}
+		else if (strcmp(arg, "--shader-cache") == 0)
+		{
+			ok = value != nullptr;
+			options->shader_cache_path = value;
+		}
+		else if (strcmp(arg, "--rewind") == 0)
+		{
+			ok = value && parse_size(value, &options->rewind_seconds);
+		}
+		else if (strcmp(arg, "--snapshot") == 0)
+		{
+			ok = value != nullptr;
+			options->snapshot_path = value;
+		}
+		else
+		{
+			ok = false;
+		}
+
+		if (!ok)
+		{
+			fprintf(stderr, "Invalid argument: %s%s%s\n", arg, value ? " " : "", value ? value : "");
+			options_usage(argv[0]);
+			return false;
+		}
+		++i;
+	}
+
+	if (options->headless && !options->replay_path && !options->max_ticks)
+	{
+		fprintf(stderr, "--headless needs --replay or --ticks\n");
+		return false;
+	}
+
+	if (options->num_games > 1 && (!options->headless ||
+		options->record_path || options->replay_path || options->snapshot_path))
+	{
+		fprintf(stderr, "--games needs --headless and cannot be combined with --record, --replay or --snapshot\n");
+		return false;
+	}
+
+	if (options->batch && (!options->headless || !options->max_ticks ||
+		options->record_path || options->replay_path || options->snapshot_path))
+	{
+		fprintf(stderr, "--batch needs --headless and --ticks and cannot be combined with --record, --replay or --snapshot\n");
+		return false;
+	}
+
+	if (options->observe_width && !options->batch)
+	{
+		fprintf(stderr, "--observe needs --batch\n");
+		return false;
+	}
+
+	if (options->frame_delay && !options->low_latency)
+	{
+		fprintf(stderr, "--frame-delay needs --low-latency\n");
+		return false;
+	}
+
+	if (options->latency && (options->headless || options->replay_path || options->input != INPUT_PLAYER))
+	{
+		fprintf(stderr, "--latency needs keyboard input in the window\n");
+		return false;
+	}
+
+	if (options->rewind_seconds && (options->record_path || options->replay_path))
+	{
+		fprintf(stderr, "--rewind cannot be combined with --record or --replay\n");
+		return false;
+	}
+
+	if (options->snapshot_path && (options->record_path || options->replay_path))
+	{
+		// Replays always start from the first tick
+		fprintf(stderr, "--snapshot cannot be combined with --record or --replay\n");
+		return false;
+	}
+
+	GameConfig& game = options->game;
+	if (num_aliens)
+	{
+		// Grow the formation by rows unless its shape was given
+		if (!formation_set)
+		{
+			game.formation_rows = (num_aliens + game.formation_columns - 1) / game.formation_columns;
+		}
+		else if (num_aliens > game.formation_columns * game.formation_rows)
+		{
+			fprintf(stderr, "%zu aliens do not fit a %zux%zu formation\n",
+				num_aliens, game.formation_columns, game.formation_rows);
+			return false;
+		}
+		game.num_aliens = num_aliens;
+	}
+	else
+	{
+		game.num_aliens = game.formation_columns * game.formation_rows;
+	}
+
+	if (!game_config_valid(game))
+	{
+		fprintf(stderr, "Formations and bullet capacities are limited to %zu\n", GAME_CONFIG_LIMIT);
+		return false;
+	}
+
+	return true;
+}
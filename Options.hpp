@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Game.hpp"
+#include "Observation.hpp"
+
+#include <cstddef>
+
+enum InputMode
+{
+	INPUT_PLAYER, // Keyboard in the window, no input headless
+	INPUT_RANDOM, // Random bot
+};
+
+struct Options
+{
+	GameConfig game;
+
+	// Print simulation and render cost per entity
+	bool stress;
+	// Stop after this many ticks, 0 to run until the window closes
+	size_t max_ticks;
+	// Workers for the job system, including the main thread
+	size_t num_threads;
+
+	// Input recording written on exit, or null
+	const char* record_path;
+	// Replay to play back instead of the keyboard, or null. Its config
+	// replaces the game options.
+	const char* replay_path;
+	// Snapshot to resume from if it exists, saved periodically and on exit,
+	// or null
+	const char* snapshot_path;
+	// Sprite atlas to map instead of the built-in sprites, or null
+	const char* atlas_path;
+	// Write the built-in sprites to this atlas and exit, or null
+	const char* write_atlas_path;
+	// Program binaries of the shaders, reused while the driver and the
+	// sources stay the same, or null to always compile
+	const char* shader_cache_path;
+	// Seconds of history to scrub back through with backspace, 0 for none
+	size_t rewind_seconds;
+	// Simulate without a window as fast as possible
+	bool headless;
+	// Independent games to run side by side headless
+	size_t num_games;
+	// Draw every tick into an offscreen buffer when headless
+	bool render;
+	// Step the games in lockstep through the batch API
+	bool batch;
+	// Batch episode length limit in ticks, 0 for none
+	size_t episode_ticks;
+	// Size of the pooled grayscale batch observations, 0 for none
+	size_t observe_width, observe_height;
+	Pooling pooling;
+	InputMode input;
+	// Do not wait for vsync in the window
+	bool unlimited;
+	// Poll, tick, draw and swap on one thread, in that order
+	bool low_latency;
+	// Microseconds to wait after each swap before sampling input with
+	// low_latency, to get closer to the next vblank
+	size_t frame_delay;
+	// Measure input-to-photon latency in the window and report it on exit
+	bool latency;
+};
+
+// Parses the command line into options, printing usage and returning false
+// on bad arguments
+bool options_parse(Options* options, int argc, char** argv);
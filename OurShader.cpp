@@ -1,48 +1,93 @@
 #include "OurShader.hpp"
 
+#include "File.hpp"
+#include "Hash.hpp"
+
+#include <cstring>
+#include <iostream>
+
 //#include "external/assimp-3.0.1270/code/MD3FileData.h"
 
 //#include <glm/gtc/type_ptr.hpp>
 
-OurShader::OurShader(const char* vertexPath, const char* fragmentPath)
+// Cache file: this header, then the driver's binary
+struct ProgramCacheHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t key;       // programKey()
+	uint32_t format;    // Driver's binary format
+	uint32_t size;
+};
+
+static const char PROGRAM_CACHE_MAGIC[4] = { 'S', 'I', 'P', 'C' };
+static const uint32_t PROGRAM_CACHE_VERSION = 1;
+
+// Whether the context can save and load at least one program binary format.
+// Binaries are core in GL 4.1 and ARB_get_program_binary before that.
+static bool programBinarySupported()
 {
-	// 1. retrieve the vertex/fragment source code from filePath
-	std::string vertexCode;
-	std::string fragmentCode;
-	std::ifstream vShaderFile;
-	std::ifstream fShaderFile;
-	// ensure ifstream objects can throw exceptions:
-	vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	bool supported = major > 4 || (major == 4 && minor >= 1);
 
-	try
+	GLint numExtensions = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+	for (GLint i = 0; i < numExtensions && !supported; i++)
 	{
-		// open Files
-		vShaderFile.open(vertexPath);
-		fShaderFile.open(fragmentPath);
-		std::stringstream vShaderStream, fShaderStream;
-		// read file's buffer contents ito streams
-		vShaderStream << vShaderFile.rdbuf();
-		fShaderStream << fShaderFile.rdbuf();
-		// close file handlers
-		vShaderFile.close();
-		fShaderFile.close();
-		// convert stream into string
-		vertexCode = vShaderStream.str();
-		fragmentCode = fShaderStream.str();
+		const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+		supported = extension && strcmp(extension, "GL_ARB_get_program_binary") == 0;
 	}
-	catch (std::ifstream::failure e)
+	if (!supported) return false;
+
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+	if (numFormats <= 0) return false;
+
+	return gl_proc_address("glGetProgramBinary") && gl_proc_address("glProgramBinary")
+		&& gl_proc_address("glProgramParameteri");
+}
+
+static uint64_t hashGLString(GLenum name, uint64_t hash)
+{
+	const char* text = reinterpret_cast<const char*>(glGetString(name));
+	return hash_string(text ? text : "", hash);
+}
+
+// A binary is only valid for the driver that produced it and the sources
+// it came from
+static uint64_t programKey(const char* vertexCode, const char* fragmentCode)
+{
+	uint64_t key = hashGLString(GL_VENDOR, HASH_SEED);
+	key = hashGLString(GL_RENDERER, key);
+	key = hashGLString(GL_VERSION, key);
+	key = hash_string(vertexCode, key);
+	return hash_string(fragmentCode, key);
+}
+
+OurShader::OurShader(const char* vertexCode, const char* fragmentCode, const char* cachePath)
+{
+	cached = false;
+
+	bool binaries = cachePath && programBinarySupported();
+	uint64_t key = binaries ? programKey(vertexCode, fragmentCode) : 0;
+	if (binaries && loadBinary(cachePath, key))
 	{
-		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << std::endl;
+		cached = true;
+	}
+	else if (compile(vertexCode, fragmentCode, binaries) && binaries)
+	{
+		saveBinary(cachePath, key);
 	}
 
-	const char* vShaderCode = vertexCode.c_str();
-	const char* fShaderCode = fragmentCode.c_str();
+	cacheUniforms();
+}
 
-	// 2. compile shaders
+bool OurShader::compile(const char* vShaderCode, const char* fShaderCode, bool retrievable)
+{
+	// 1. compile shaders
 	unsigned int vertex, fragment;
-	//int success;
-	//char infoLog[512];
 
 	// vertex shader
 	vertex = glCreateShader(GL_VERTEX_SHADER);
@@ -58,16 +103,77 @@ OurShader::OurShader(const char* vertexPath, const char* fragmentPath)
 	// print compile errors if ay
 	checkCompileErrors(fragment, "FRAGMENT");
 
-	// shader Program
+	// 2. shader Program
 	ID = glCreateProgram();
+	if (retrievable) glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glAttachShader(ID, vertex);
 	glAttachShader(ID, fragment);
 	glLinkProgram(ID);
-	checkCompileErrors(ID, "PROGRAM");
+	bool linked = checkCompileErrors(ID, "PROGRAM");
 
 	// delete the shaders as they're linked ito our program now and no longer necessary
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
+	return linked;
+}
+
+bool OurShader::loadBinary(const char* cachePath, uint64_t key)
+{
+	MappedFile file;
+	if (!file_map(&file, cachePath)) return false;
+
+	ProgramCacheHeader header;
+	bool valid = file.size >= sizeof(header);
+	if (valid)
+	{
+		memcpy(&header, file.data, sizeof(header));
+		valid = memcmp(header.magic, PROGRAM_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+			header.version == PROGRAM_CACHE_VERSION && header.key == key &&
+			header.size == file.size - sizeof(header);
+	}
+
+	// The driver may still turn a binary down, after an update for one
+	bool linked = false;
+	if (valid)
+	{
+		ID = glCreateProgram();
+		glProgramBinary(ID, header.format, file.data + sizeof(header), static_cast<GLsizei>(header.size));
+
+		int success;
+		glGetProgramiv(ID, GL_LINK_STATUS, &success);
+		linked = success != 0;
+		if (!linked) glDeleteProgram(ID);
+	}
+
+	file_unmap(&file);
+	return linked;
+}
+
+void OurShader::saveBinary(const char* cachePath, uint64_t key) const
+{
+	GLint length = 0;
+	glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) return;
+
+	uint8_t* data = new uint8_t[sizeof(ProgramCacheHeader) + length];
+	ProgramCacheHeader header = {};
+	memcpy(header.magic, PROGRAM_CACHE_MAGIC, sizeof(header.magic));
+	header.version = PROGRAM_CACHE_VERSION;
+	header.key = key;
+
+	GLsizei written = 0;
+	GLenum format = 0;
+	glGetProgramBinary(ID, length, &written, &format, data + sizeof(header));
+	header.format = format;
+	header.size = static_cast<uint32_t>(written);
+	memcpy(data, &header, sizeof(header));
+
+	if (written > 0 && !file_write(cachePath, data, sizeof(header) + header.size))
+	{
+		std::cout << "Failed to write shader cache " << cachePath << std::endl;
+	}
+
+	delete[] data;
 }
 
 void OurShader::use()
@@ -75,27 +181,83 @@ void OurShader::use()
 	glUseProgram(ID);
 }
 
-void OurShader::setBool(const std::string& name, bool value) const
+int OurShader::location(uint64_t hash) const
+{
+	for (size_t i = 0; i < numUniforms; i++)
+	{
+		if (uniformHashes[i] == hash) return uniformLocations[i];
+	}
+	return -1;
+}
+
+void OurShader::cacheUniforms()
+{
+	numUniforms = 0;
+
+	GLint count = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+	for (GLint i = 0; i < count; i++)
+	{
+		char name[256];
+		GLsizei length = 0;
+		GLint size;
+		GLenum type;
+		glGetActiveUniform(ID, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+
+		// Arrays are listed as name[0], found by their plain name
+		if (length > 3 && strcmp(name + length - 3, "[0]") == 0) length -= 3;
+		name[length] = '\0';
+
+		GLint location = glGetUniformLocation(ID, name);
+		if (location < 0) continue; // Block members have no location
+
+		if (numUniforms == MAX_UNIFORMS)
+		{
+			std::cout << "Too many uniforms, ignoring " << name << std::endl;
+			continue;
+		}
+		uniformHashes[numUniforms] = hash_string(name);
+		uniformLocations[numUniforms] = location;
+		++numUniforms;
+	}
+}
+
+void OurShader::set(Uniform<bool> handle, bool value) const
+{
+	glUniform1i(handle.location, (int)value);
+}
+
+void OurShader::set(Uniform<int> handle, int value) const
+{
+	glUniform1i(handle.location, value);
+}
+
+void OurShader::set(Uniform<float> handle, float value) const
+{
+	glUniform1f(handle.location, value);
+}
+
+void OurShader::setBool(UniformName name, bool value) const
 {
-	glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+	set(uniform<bool>(name), value);
 }
 
-void OurShader::setInt(const std::string& name, int value) const
+void OurShader::setInt(UniformName name, int value) const
 {
-	glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+	set(uniform<int>(name), value);
 }
 
-void OurShader::setFloat(const std::string& name, float value) const
+void OurShader::setFloat(UniformName name, float value) const
 {
-	glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+	set(uniform<float>(name), value);
 }
 
 
-void OurShader::checkCompileErrors(unsigned shader, std::string type)
+bool OurShader::checkCompileErrors(unsigned shader, const char* type)
 {
 	int success;
 	char infoLog[1024];
-	if (type != "PROGRAM")
+	if (strcmp(type, "PROGRAM") != 0)
 	{
 		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
 		if (!success)
@@ -119,4 +281,5 @@ void OurShader::checkCompileErrors(unsigned shader, std::string type)
 				<< std::endl;
 		}
 	}
+	return success != 0;
 }
@@ -1,33 +1,72 @@
 #pragma once
-#pragma once
 
-#include <glad/glad.h>
+#include "GL.hpp"
+#include "Hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
 
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
 
+// Uniform name hashed by the compiler, so looking a uniform up does no
+// string work at run time. Only literals convert to it.
+struct UniformName
+{
+	uint64_t hash;
+
+	consteval UniformName(const char* name) : hash(hash_string(name)) {}
+};
+
+// Location of a uniform of type T (int, float or bool), -1 if the program
+// has no such uniform, which GL then ignores
+template<typename T>
+struct Uniform
+{
+	int location;
+};
 
 class OurShader
 {
 public:
 	// the program ID
 	unsigned int ID;
+	// whether the program was loaded from the binary cache
+	bool cached;
+
+	// active uniforms of the program, resolved once after linking
+	static const size_t MAX_UNIFORMS = 16;
+	size_t numUniforms;
+	uint64_t uniformHashes[MAX_UNIFORMS];
+	int uniformLocations[MAX_UNIFORMS];
 
-	// constructor reads and builds the shader
-	OurShader(const char* vertexPath, const char* fragmentPath);
+	// constructor builds the shader from GLSL sources. With a cache path, a
+	// program binary saved there by an earlier run with the same driver and
+	// sources is loaded instead of compiling, and a fresh compile is saved.
+	OurShader(const char* vertexCode, const char* fragmentCode, const char* cachePath = nullptr);
 	// use/activade the shader
 	void use();
-	// utility uniform functions
-	void setBool(const std::string& name, bool value) const;
-	void setInt(const std::string& name, int value) const;
-	void setFloat(const std::string& name, float value) const;
+	// typed handle for a uniform, to look up once and set every frame
+	template<typename T>
+	Uniform<T> uniform(UniformName name) const
+	{
+		return { location(name.hash) };
+	}
+	// utility uniform functions, on the program in use
+	void set(Uniform<bool> handle, bool value) const;
+	void set(Uniform<int> handle, int value) const;
+	void set(Uniform<float> handle, float value) const;
+	void setBool(UniformName name, bool value) const;
+	void setInt(UniformName name, int value) const;
+	void setFloat(UniformName name, float value) const;
 	/*void setMat4(const std::string& name, glm::mat4& value) const;
 	void setVec3(const std::string& name, glm::vec3& value) const;
 	void setVec3(const std::string& name, const float x, const float y,
 		const float z) const;*/
 
 private:
-	void checkCompileErrors(unsigned int shader, std::string type);
+	int location(uint64_t hash) const;
+	void cacheUniforms();
+	bool compile(const char* vertexCode, const char* fragmentCode, bool retrievable);
+	bool loadBinary(const char* cachePath, uint64_t key);
+	void saveBinary(const char* cachePath, uint64_t key) const;
+	bool checkCompileErrors(unsigned int shader, const char* type);
 };
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+// PCG32 generator. All simulation randomness goes through a seeded
+// Random stored in the game state so runs can be reproduced exactly.
+
+struct Random
+{
+	uint64_t state;
+	uint64_t increment;
+};
+
+inline uint32_t random_next(Random* random)
+{
+	uint64_t state = random->state;
+	random->state = state * 6364136223846793005ull + random->increment;
+
+	uint32_t xorshifted = static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+	uint32_t rotation = static_cast<uint32_t>(state >> 59);
+	return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+inline void random_seed(Random* random, uint64_t seed, uint64_t stream = 0)
+{
+	random->state = 0;
+	random->increment = (stream << 1) | 1;
+	random_next(random);
+	random->state += seed;
+	random_next(random);
+}
+
+// Uniform value in [0, bound) without modulo bias
+inline uint32_t random_range(Random* random, uint32_t bound)
+{
+	if (bound == 0) return 0;
+
+	uint32_t threshold = (0u - bound) % bound;
+	for (;;)
+	{
+		uint32_t value = random_next(random);
+		if (value >= threshold) return value % bound;
+	}
+}
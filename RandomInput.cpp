@@ -0,0 +1,21 @@
+#include "RandomInput.hpp"
+
+void random_input_init(RandomInput* bot, uint64_t seed, uint64_t stream)
+{
+	random_seed(&bot->random, seed, stream);
+	bot->input = { 0, false };
+	bot->hold = 0;
+}
+
+GameInput random_input_next(RandomInput* bot)
+{
+	if (bot->hold == 0)
+	{
+		bot->input.move_dir = static_cast<int>(random_range(&bot->random, 3)) - 1;
+		bot->hold = 8 + random_range(&bot->random, 57);
+	}
+	--bot->hold;
+
+	bot->input.fire = random_range(&bot->random, 8) == 0;
+	return bot->input;
+}
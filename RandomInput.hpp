@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Game.hpp"
+#include "Random.hpp"
+
+#include <cstdint>
+
+// Stand-in player for automated runs: holds a random direction for a
+// while and fires at random. Seeded, so a run can be repeated exactly.
+
+struct RandomInput
+{
+	Random random;
+	GameInput input;
+	uint32_t hold; // Ticks left before picking a new direction
+};
+
+void random_input_init(RandomInput* bot, uint64_t seed, uint64_t stream);
+GameInput random_input_next(RandomInput* bot);
@@ -0,0 +1,139 @@
+#include "RenderState.hpp"
+
+#include <cstring>
+
+void render_state_init(RenderState* state, size_t draw_capacity)
+{
+	*state = {};
+	state->draw_capacity = draw_capacity;
+	state->draws = new RenderSprite[draw_capacity];
+}
+
+void render_state_free(RenderState* state)
+{
+	delete[] state->draws;
+	*state = {};
+}
+
+void render_state_capture(RenderState* state, Game& game)
+{
+	state->tick = game.tick;
+	state->score = game.score;
+	state->width = game.width;
+	state->height = game.height;
+	state->sprites = game.sprites;
+	state->input_time = 0;
+	state->input_press = 0;
+	memcpy(state->shields, game.shields, sizeof(state->shields));
+
+	// Aliens, bullets and the player
+	size_t num_draws = 1;
+	size_t cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, ALIEN_COMPONENTS, &cursor))
+	{
+		num_draws += archetype->count;
+	}
+	cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, BULLET_COMPONENTS, &cursor))
+	{
+		num_draws += archetype->count;
+	}
+
+	if (num_draws > state->draw_capacity)
+	{
+		delete[] state->draws;
+		state->draw_capacity = 2 * num_draws;
+		state->draws = new RenderSprite[state->draw_capacity];
+	}
+
+	const Sprites& sprites = *game.sprites;
+	RenderSprite* draw = state->draws;
+
+	cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, ALIEN_COMPONENTS, &cursor))
+	{
+		const Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		const Alien* aliens = ecs_column<Alien>(archetype, COMPONENT_ALIEN);
+		for (size_t ai = 0; ai < archetype->count; ai++)
+		{
+			draw->sprite = aliens[ai].type == ALIEN_DEAD ?
+				&sprites.alien_death : &game_alien_sprite(game, aliens[ai].type);
+			draw->x = fixed_to_int(positions[ai].x);
+			draw->y = fixed_to_int(positions[ai].y);
+			++draw;
+		}
+	}
+	state->num_alien_draws = static_cast<size_t>(draw - state->draws);
+
+	cursor = 0;
+	while (const Archetype* archetype = ecs_next(&game.world, BULLET_COMPONENTS, &cursor))
+	{
+		const Position* positions = ecs_column<Position>(archetype, COMPONENT_POSITION);
+		for (size_t bi = 0; bi < archetype->count; bi++)
+		{
+			*draw++ = { &sprites.bullet, fixed_to_int(positions[bi].x), fixed_to_int(positions[bi].y) };
+		}
+	}
+
+	const Position& player = *ecs_get<Position>(&game.world, game.player, COMPONENT_POSITION);
+	*draw++ = { &sprites.player, fixed_to_int(player.x), fixed_to_int(player.y) };
+
+	state->num_draws = static_cast<size_t>(draw - state->draws);
+}
+
+void render_state_draw(const RenderState& state, Buffer* buffer, uint32_t clear_color)
+{
+	uint32_t color = rgb_to_uint32(128, 0, 0);
+
+	buffer_clear(buffer, clear_color);
+	buffer_draw_hud(buffer, *state.sprites, state.width, state.height, state.score);
+
+	// In the order of buffer_draw_game(): aliens, shields, the rest
+	for (size_t i = 0; i < state.num_draws; i++)
+	{
+		if (i == state.num_alien_draws) buffer_draw_shields(buffer, state.shields, color);
+		const RenderSprite& draw = state.draws[i];
+		buffer_draw_sprite(buffer, *draw.sprite, static_cast<size_t>(draw.x), static_cast<size_t>(draw.y), color);
+	}
+}
+
+void render_queue_init(RenderQueue* queue, size_t draw_capacity)
+{
+	for (size_t i = 0; i < 3; i++)
+	{
+		render_state_init(&queue->states[i], draw_capacity);
+	}
+	queue->back = 0;
+	queue->waiting.store(1, std::memory_order_relaxed);
+	queue->front = 2;
+}
+
+void render_queue_free(RenderQueue* queue)
+{
+	for (size_t i = 0; i < 3; i++)
+	{
+		render_state_free(&queue->states[i]);
+	}
+}
+
+RenderState* render_queue_back(RenderQueue* queue)
+{
+	return &queue->states[queue->back];
+}
+
+void render_queue_publish(RenderQueue* queue)
+{
+	// Release hands the written state over, acquire takes back the one the
+	// renderer let go of
+	uint32_t previous = queue->waiting.exchange(queue->back | RENDER_QUEUE_FRESH, std::memory_order_acq_rel);
+	queue->back = previous & ~RENDER_QUEUE_FRESH;
+}
+
+const RenderState* render_queue_acquire(RenderQueue* queue)
+{
+	if (!(queue->waiting.load(std::memory_order_relaxed) & RENDER_QUEUE_FRESH)) return nullptr;
+
+	uint32_t previous = queue->waiting.exchange(queue->front, std::memory_order_acq_rel);
+	queue->front = previous & ~RENDER_QUEUE_FRESH;
+	return &queue->states[queue->front];
+}
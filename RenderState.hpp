@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include "Game.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Everything the renderer needs from one tick, copied out of the game so
+// the simulation can move on while it is drawn. A state only points at the
+// sprites, which stay put for as long as the game runs.
+
+struct RenderSprite
+{
+	const Sprite* sprite;
+	int32_t x, y;
+};
+
+struct RenderState
+{
+	uint64_t tick, score;
+	size_t width, height;
+	const Sprites* sprites;
+	Shield shields[SHIELD_COUNT];
+
+	// Arrival time of the key press with latency tag input_press, whose
+	// effect this state shows, 0 for none. Cleared by render_state_capture()
+	// for the simulation to set.
+	int64_t input_time;
+	uint64_t input_press;
+
+	// The aliens come first, num_alien_draws of them, then the bullets and
+	// the player. The shields are drawn in between.
+	size_t num_draws, num_alien_draws, draw_capacity;
+	RenderSprite* draws;
+};
+
+void render_state_init(RenderState* state, size_t draw_capacity);
+void render_state_free(RenderState* state);
+
+// Copies what is visible in game, growing the draw list if needed
+void render_state_capture(RenderState* state, Game& game);
+
+// Draws the same frame buffer_draw_game() would have for the captured tick
+void render_state_draw(const RenderState& state, Buffer* buffer, uint32_t clear_color);
+
+// Lock-free triple buffer between one simulation thread and one render
+// thread. Each side owns a state and the third waits in between:
+// publishing trades the simulation's freshly written state for the waiting
+// one and acquiring trades the renderer's state for it. Neither side ever
+// blocks and the renderer always gets the newest complete tick.
+
+// Set in RenderQueue::waiting while the waiting state has not been acquired
+const uint32_t RENDER_QUEUE_FRESH = 4;
+
+struct RenderQueue
+{
+	RenderState states[3];
+
+	// Index of the waiting state, swapped by both sides
+	std::atomic<uint32_t> waiting;
+	uint8_t waiting_padding[64 - sizeof(std::atomic<uint32_t>)];
+	// Owned by the simulation and the renderer respectively
+	uint32_t back;
+	uint8_t back_padding[64 - sizeof(uint32_t)];
+	uint32_t front;
+};
+
+void render_queue_init(RenderQueue* queue, size_t draw_capacity);
+void render_queue_free(RenderQueue* queue);
+
+// Simulation side: capture into render_queue_back(), then publish it
+RenderState* render_queue_back(RenderQueue* queue);
+void render_queue_publish(RenderQueue* queue);
+
+// Render side. Returns the newest published state, or null if nothing was
+// published since the last call.
+const RenderState* render_queue_acquire(RenderQueue* queue);
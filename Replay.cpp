@@ -0,0 +1,207 @@
+#include "Replay.hpp"
+#include "Varint.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+static const char REPLAY_MAGIC[4] = { 'S', 'I', 'R', 'P' };
+
+// Input byte: bit 0 moves right, bit 1 moves left, bit 2 fires
+static uint8_t input_encode(const GameInput& input)
+{
+	uint8_t bits = 0;
+	if (input.move_dir > 0) bits |= 1;
+	if (input.move_dir < 0) bits |= 2;
+	if (input.fire) bits |= 4;
+	return bits;
+}
+
+static GameInput input_decode(uint8_t bits)
+{
+	GameInput input;
+	input.move_dir = (bits & 1) - ((bits >> 1) & 1);
+	input.fire = (bits & 4) != 0;
+	return input;
+}
+
+void replay_init(Replay* replay, const GameConfig& config)
+{
+	replay->config = config;
+	replay->num_ticks = 0;
+	replay->checksum = 0;
+	replay->num_runs = 0;
+	replay->run_capacity = 0;
+	replay->runs = nullptr;
+	replay->run = 0;
+	replay->run_tick = 0;
+}
+
+void replay_free(Replay* replay)
+{
+	delete[] replay->runs;
+	replay->runs = nullptr;
+	replay->num_runs = replay->run_capacity = 0;
+}
+
+static void replay_push_run(Replay* replay, uint8_t input, uint64_t length)
+{
+	if (replay->num_runs == replay->run_capacity)
+	{
+		size_t capacity = replay->run_capacity ? 2 * replay->run_capacity : 64;
+		ReplayRun* runs = new ReplayRun[capacity];
+		if (replay->num_runs) memcpy(runs, replay->runs, replay->num_runs * sizeof(ReplayRun));
+		delete[] replay->runs;
+		replay->runs = runs;
+		replay->run_capacity = capacity;
+	}
+
+	replay->runs[replay->num_runs++] = { input, length };
+}
+
+void replay_record(Replay* replay, const GameInput& input)
+{
+	uint8_t bits = input_encode(input);
+	if (replay->num_runs && replay->runs[replay->num_runs - 1].input == bits)
+	{
+		++replay->runs[replay->num_runs - 1].length;
+	}
+	else
+	{
+		replay_push_run(replay, bits, 1);
+	}
+	++replay->num_ticks;
+}
+
+bool replay_save(const Replay* replay, const char* path)
+{
+	// Header plus the worst case for every run
+	const size_t HEADER_MAX = sizeof(REPLAY_MAGIC) + 1 + 7 * VARINT_MAX_BYTES + 8;
+	uint8_t* data = new uint8_t[HEADER_MAX + replay->num_runs * (1 + VARINT_MAX_BYTES)];
+	uint8_t* cursor = data;
+
+	memcpy(cursor, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	cursor += sizeof(REPLAY_MAGIC);
+	*cursor++ = REPLAY_VERSION;
+
+	const GameConfig& config = replay->config;
+	write_varint(&cursor, config.seed);
+	write_varint(&cursor, config.formation_columns);
+	write_varint(&cursor, config.formation_rows);
+	write_varint(&cursor, config.num_aliens);
+	write_varint(&cursor, config.max_bullets);
+	write_varint(&cursor, config.fire_rate);
+	write_varint(&cursor, replay->num_ticks);
+	for (int i = 0; i < 8; i++)
+	{
+		*cursor++ = static_cast<uint8_t>(replay->checksum >> (8 * i));
+	}
+
+	for (size_t i = 0; i < replay->num_runs; i++)
+	{
+		*cursor++ = replay->runs[i].input;
+		write_varint(&cursor, replay->runs[i].length);
+	}
+
+	size_t size = static_cast<size_t>(cursor - data);
+	FILE* file = fopen(path, "wb");
+	bool ok = file && fwrite(data, 1, size, file) == size;
+	if (file && fclose(file) != 0) ok = false;
+	delete[] data;
+
+	if (!ok) fprintf(stderr, "Failed to write replay %s\n", path);
+	return ok;
+}
+
+static bool replay_parse(Replay* replay, const uint8_t* data, size_t size)
+{
+	const uint8_t* cursor = data;
+	const uint8_t* end = data + size;
+
+	if (size < sizeof(REPLAY_MAGIC) + 1 || memcmp(cursor, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) return false;
+	cursor += sizeof(REPLAY_MAGIC);
+	if (*cursor++ != REPLAY_VERSION) return false;
+
+	uint64_t fields[7];
+	for (uint64_t& field : fields)
+	{
+		if (!read_varint(&cursor, end, &field)) return false;
+	}
+	if (end - cursor < 8) return false;
+
+	GameConfig config;
+	config.seed = fields[0];
+	config.formation_columns = static_cast<size_t>(fields[1]);
+	config.formation_rows = static_cast<size_t>(fields[2]);
+	config.num_aliens = static_cast<size_t>(fields[3]);
+	config.max_bullets = static_cast<size_t>(fields[4]);
+	config.fire_rate = static_cast<size_t>(fields[5]);
+	if (!game_config_valid(config)) return false;
+
+	replay_init(replay, config);
+	uint64_t num_ticks = fields[6];
+	for (int i = 0; i < 8; i++)
+	{
+		replay->checksum |= static_cast<uint64_t>(*cursor++) << (8 * i);
+	}
+
+	while (replay->num_ticks < num_ticks)
+	{
+		if (cursor == end) return false;
+
+		uint8_t input = *cursor++;
+		uint64_t length;
+		if (input > 7 || !read_varint(&cursor, end, &length) || length == 0 ||
+			length > num_ticks - replay->num_ticks)
+		{
+			return false;
+		}
+
+		replay_push_run(replay, input, length);
+		replay->num_ticks += length;
+	}
+
+	return cursor == end;
+}
+
+bool replay_load(Replay* replay, const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open replay %s\n", path);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	uint8_t* data = new uint8_t[size > 0 ? size : 1];
+	bool ok = size > 0 && fread(data, 1, static_cast<size_t>(size), file) == static_cast<size_t>(size);
+	fclose(file);
+
+	replay->runs = nullptr;
+	if (ok) ok = replay_parse(replay, data, static_cast<size_t>(size));
+	delete[] data;
+
+	if (!ok)
+	{
+		replay_free(replay);
+		fprintf(stderr, "Invalid replay %s\n", path);
+	}
+	return ok;
+}
+
+bool replay_next(Replay* replay, GameInput* input)
+{
+	if (replay->run == replay->num_runs) return false;
+
+	const ReplayRun& run = replay->runs[replay->run];
+	*input = input_decode(run.input);
+	if (++replay->run_tick == run.length)
+	{
+		++replay->run;
+		replay->run_tick = 0;
+	}
+	return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Input recording. A replay holds the config the game was started with and
+// its input as runs of identical ticks, which is all the deterministic
+// simulation needs to reproduce a session exactly.
+//
+// File layout, all integers as LEB128 varints unless noted:
+//   "SIRP"                    magic, 4 bytes
+//   version                   1 byte
+//   seed, formation columns, formation rows, aliens, bullets, fire rate
+//   ticks                     total number of recorded ticks
+//   checksum                  game_checksum() after the last tick, 8 bytes
+//   runs                      (input byte, length in ticks) until ticks
+//                             are covered; each length is the tick delta
+//                             to the next input change
+
+// A replay holds only inputs, so the version goes up whenever the same
+// inputs stop producing the same game, and older replays are rejected
+const uint8_t REPLAY_VERSION = 3;
+
+struct ReplayRun
+{
+	uint8_t input;
+	uint64_t length;
+};
+
+struct Replay
+{
+	GameConfig config;
+	uint64_t num_ticks;
+	uint64_t checksum;
+
+	size_t num_runs, run_capacity;
+	ReplayRun* runs;
+
+	// Playback position
+	size_t run;
+	uint64_t run_tick;
+};
+
+// Starts an empty recording for a game created with config
+void replay_init(Replay* replay, const GameConfig& config);
+void replay_free(Replay* replay);
+
+// Appends the input of one tick
+void replay_record(Replay* replay, const GameInput& input);
+
+// Writes the replay in a single call. Returns false on I/O errors.
+bool replay_save(const Replay* replay, const char* path);
+
+// Reads a replay written by replay_save() and rewinds it. Returns false
+// if the file cannot be read or is malformed.
+bool replay_load(Replay* replay, const char* path);
+
+// Fetches the input of the next tick, false once the replay is over
+bool replay_next(Replay* replay, GameInput* input);
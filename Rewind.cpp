@@ -0,0 +1,265 @@
+#include "Rewind.hpp"
+#include "Snapshot.hpp"
+#include "Varint.hpp"
+
+#include <cstring>
+
+// Zero bytes it takes to end a literal run
+static const size_t REWIND_MIN_RUN = 8;
+
+static size_t encoded_bound(size_t size)
+{
+	return size + (size / REWIND_MIN_RUN + 2) * 2 * VARINT_MAX_BYTES;
+}
+
+static uint8_t delta_byte(const uint8_t* state, const uint8_t* reference, size_t reference_size, size_t i)
+{
+	return i < reference_size ? state[i] ^ reference[i] : state[i];
+}
+
+// Encodes state XOR reference as tokens of (zero run, literal run) varints
+// followed by the literal bytes. Past the end of reference it counts as
+// zeros, so a null reference encodes state itself.
+static size_t delta_encode(
+	const uint8_t* state, size_t size, const uint8_t* reference, size_t reference_size, uint8_t* out
+)
+{
+	uint8_t* cursor = out;
+	size_t i = 0;
+	while (i < size)
+	{
+		size_t start = i;
+		while (start < size && delta_byte(state, reference, reference_size, start) == 0) ++start;
+
+		// Literals run until REWIND_MIN_RUN zeros in a row
+		size_t end = start;
+		size_t run = 0;
+		while (end + run < size && run < REWIND_MIN_RUN)
+		{
+			if (delta_byte(state, reference, reference_size, end + run) == 0)
+			{
+				++run;
+			}
+			else
+			{
+				end += run + 1;
+				run = 0;
+			}
+		}
+
+		write_varint(&cursor, start - i);
+		write_varint(&cursor, end - start);
+		for (size_t k = start; k < end; k++)
+		{
+			*cursor++ = delta_byte(state, reference, reference_size, k);
+		}
+		i = end;
+	}
+
+	return static_cast<size_t>(cursor - out);
+}
+
+// XORs an encoded delta into data
+static void delta_apply(uint8_t* data, const uint8_t* encoded, size_t encoded_size)
+{
+	const uint8_t* cursor = encoded;
+	const uint8_t* end = encoded + encoded_size;
+	size_t i = 0;
+	while (cursor < end)
+	{
+		uint64_t zeros, literals;
+		if (!read_varint(&cursor, end, &zeros) || !read_varint(&cursor, end, &literals)) break;
+
+		i += static_cast<size_t>(zeros);
+		for (uint64_t k = 0; k < literals; k++)
+		{
+			data[i++] ^= *cursor++;
+		}
+	}
+}
+
+static RewindFrame& frame_at(const Rewind* rewind, size_t i)
+{
+	return rewind->frames[(rewind->first_frame + i) % rewind->max_frames];
+}
+
+void rewind_init(Rewind* rewind, size_t max_ticks, size_t capacity)
+{
+	*rewind = {};
+	rewind->max_frames = max_ticks ? max_ticks : 1;
+	rewind->frames = new RewindFrame[rewind->max_frames];
+	rewind->capacity = capacity;
+	rewind->data = new uint8_t[capacity];
+}
+
+void rewind_free(Rewind* rewind)
+{
+	delete[] rewind->frames;
+	delete[] rewind->data;
+	delete[] rewind->keyframe;
+	delete[] rewind->state;
+	delete[] rewind->encoded;
+	*rewind = {};
+}
+
+static void rewind_reserve(Rewind* rewind, size_t size)
+{
+	if (size <= rewind->scratch_capacity) return;
+
+	delete[] rewind->state;
+	delete[] rewind->encoded;
+	rewind->scratch_capacity = size;
+	rewind->state = new uint8_t[size];
+	rewind->encoded = new uint8_t[encoded_bound(size)];
+}
+
+// Drops the oldest segment, its deltas are useless without the keyframe
+static void rewind_drop_oldest(Rewind* rewind)
+{
+	do
+	{
+		rewind->first_frame = (rewind->first_frame + 1) % rewind->max_frames;
+		--rewind->num_frames;
+	} while (rewind->num_frames && !frame_at(rewind, 0).keyframe);
+}
+
+static bool frame_overlaps(const RewindFrame& frame, size_t offset, size_t size)
+{
+	return frame.offset < offset + size && offset < frame.offset + frame.size;
+}
+
+// Finds room for size bytes after the newest frame, dropping the oldest
+// segments it runs into
+static size_t rewind_allocate(Rewind* rewind, size_t size)
+{
+	if (!rewind->num_frames) rewind->head = 0;
+
+	size_t offset = rewind->head;
+	if (offset + size > rewind->capacity)
+	{
+		// Frames past the head are older than the ones before it
+		while (rewind->num_frames && frame_at(rewind, 0).offset >= rewind->head)
+		{
+			rewind_drop_oldest(rewind);
+		}
+		offset = 0;
+	}
+
+	while (rewind->num_frames && frame_overlaps(frame_at(rewind, 0), offset, size))
+	{
+		rewind_drop_oldest(rewind);
+	}
+
+	rewind->head = offset + size;
+	return offset;
+}
+
+void rewind_record(Rewind* rewind, const Game& game)
+{
+	// Recording after a restore starts a new future
+	while (rewind->num_frames && frame_at(rewind, rewind->num_frames - 1).tick >= game.tick)
+	{
+		--rewind->num_frames;
+	}
+	if (rewind->num_frames)
+	{
+		const RewindFrame& newest = frame_at(rewind, rewind->num_frames - 1);
+		rewind->head = newest.offset + newest.size;
+	}
+
+	// Padded so arrays keep their offsets and only real changes show up
+	size_t size = snapshot_size(game, true);
+	rewind_reserve(rewind, size);
+	snapshot_write(game, rewind->state, true);
+
+	bool keyframe = rewind->num_frames == 0 ||
+		rewind->keyframe_tick > frame_at(rewind, rewind->num_frames - 1).tick ||
+		game.tick - rewind->keyframe_tick >= REWIND_KEYFRAME_INTERVAL;
+
+	if (rewind->num_frames == rewind->max_frames) rewind_drop_oldest(rewind);
+
+	for (;;)
+	{
+		size_t encoded_size = keyframe ?
+			delta_encode(rewind->state, size, nullptr, 0, rewind->encoded) :
+			delta_encode(rewind->state, size, rewind->keyframe, rewind->keyframe_size, rewind->encoded);
+		if (encoded_size > rewind->capacity)
+		{
+			// Does not fit at all, start over with the next tick
+			rewind->num_frames = 0;
+			return;
+		}
+
+		size_t offset = rewind_allocate(rewind, encoded_size);
+		if (!keyframe && !rewind->num_frames)
+		{
+			// Making room dropped the keyframe this delta refers to
+			keyframe = true;
+			continue;
+		}
+
+		memcpy(rewind->data + offset, rewind->encoded, encoded_size);
+		RewindFrame& frame = frame_at(rewind, rewind->num_frames++);
+		frame.tick = game.tick;
+		frame.offset = offset;
+		frame.size = encoded_size;
+		frame.state_size = size;
+		frame.keyframe = keyframe;
+		break;
+	}
+
+	if (keyframe)
+	{
+		if (size > rewind->keyframe_capacity)
+		{
+			delete[] rewind->keyframe;
+			rewind->keyframe_capacity = size;
+			rewind->keyframe = new uint8_t[size];
+		}
+		memcpy(rewind->keyframe, rewind->state, size);
+		rewind->keyframe_size = size;
+		rewind->keyframe_tick = game.tick;
+	}
+}
+
+bool rewind_range(const Rewind* rewind, uint64_t* oldest, uint64_t* newest)
+{
+	if (!rewind->num_frames) return false;
+
+	*oldest = frame_at(rewind, 0).tick;
+	*newest = frame_at(rewind, rewind->num_frames - 1).tick;
+	return true;
+}
+
+bool rewind_restore(Rewind* rewind, Game* game, uint64_t tick)
+{
+	// Frames are in tick order
+	size_t low = 0;
+	size_t high = rewind->num_frames;
+	while (low < high)
+	{
+		size_t middle = (low + high) / 2;
+		if (frame_at(rewind, middle).tick < tick) low = middle + 1;
+		else high = middle;
+	}
+	if (low == rewind->num_frames || frame_at(rewind, low).tick != tick) return false;
+
+	// At most REWIND_KEYFRAME_INTERVAL frames back
+	size_t key = low;
+	while (!frame_at(rewind, key).keyframe) --key;
+
+	const RewindFrame& keyframe = frame_at(rewind, key);
+	const RewindFrame& frame = frame_at(rewind, low);
+	size_t size = keyframe.state_size > frame.state_size ? keyframe.state_size : frame.state_size;
+	rewind_reserve(rewind, size);
+
+	// Both deltas treat bytes past the keyframe as zeros
+	memset(rewind->state, 0, size);
+	delta_apply(rewind->state, rewind->data + keyframe.offset, keyframe.size);
+	if (key != low)
+	{
+		delta_apply(rewind->state, rewind->data + frame.offset, frame.size);
+	}
+
+	return snapshot_restore(game, rewind->state, frame.state_size);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// History of the last ticks for scrubbing backward. Every tick's snapshot
+// is XORed against the keyframe that starts its segment and the result is
+// run-length encoded, so unchanged bytes cost almost nothing. Restoring a
+// tick decodes its keyframe and one delta, whatever its age.
+//
+// Frames live in a fixed byte ring. When it or the frame table fills up,
+// the oldest segment is dropped as a whole.
+
+const size_t REWIND_KEYFRAME_INTERVAL = 60;
+
+struct RewindFrame
+{
+	uint64_t tick;
+	size_t offset, size; // Encoded bytes in the ring
+	size_t state_size;   // Decoded snapshot size
+	bool keyframe;
+};
+
+struct Rewind
+{
+	size_t max_frames;
+	size_t first_frame, num_frames;
+	RewindFrame* frames;
+
+	size_t capacity;
+	size_t head;         // Where the next frame goes
+	uint8_t* data;
+
+	// Decoded keyframe the newest frames are encoded against
+	uint64_t keyframe_tick;
+	size_t keyframe_size, keyframe_capacity;
+	uint8_t* keyframe;
+
+	size_t scratch_capacity;
+	uint8_t* state;
+	uint8_t* encoded;
+};
+
+// Keeps up to max_ticks ticks in capacity bytes
+void rewind_init(Rewind* rewind, size_t max_ticks, size_t capacity);
+void rewind_free(Rewind* rewind);
+
+// Stores the state of game after a tick. Frames at or after its tick are
+// dropped first, so recording after a restore continues from there.
+void rewind_record(Rewind* rewind, const Game& game);
+
+// Oldest and newest recorded ticks, false if nothing is recorded
+bool rewind_range(const Rewind* rewind, uint64_t* oldest, uint64_t* newest);
+
+// Puts game back to the state it had at tick. Returns false if the tick is
+// no longer recorded.
+bool rewind_restore(Rewind* rewind, Game* game, uint64_t tick);
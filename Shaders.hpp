@@ -0,0 +1,31 @@
+#pragma once
+
+// GLSL sources of the screen program, built into the executable
+
+// Fullscreen triangle from gl_VertexID, no vertex buffers
+const char SCREEN_VERTEX_SHADER[] = R"glsl(#version 330
+
+noperspective out vec2 TexCoord;
+
+void main(void)
+{
+	TexCoord.x = (gl_VertexID == 2) ? 2.0: 0.0;
+	TexCoord.y = (gl_VertexID == 1) ? 2.0: 0.0;
+
+	gl_Position = vec4(2.0 * TexCoord - 1.0, 0.0, 1.0);
+};
+)glsl";
+
+// Shows the software framebuffer bound to unit 0
+const char SCREEN_FRAGMENT_SHADER[] = R"glsl(#version 330
+
+uniform sampler2D buffer;
+noperspective in vec2 TexCoord;
+
+out vec3 outColor;
+
+void main(void)
+{
+	outColor = texture(buffer, TexCoord).rgb;
+};
+)glsl";
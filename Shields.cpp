@@ -0,0 +1,109 @@
+#include "Shields.hpp"
+
+#include <bit>
+
+static const uint32_t SHIELD_ROWS[SHIELD_HEIGHT] =
+{
+	0b0000111111111111110000, // ....@@@@@@@@@@@@@@....
+	0b0001111111111111111000, // ...@@@@@@@@@@@@@@@@...
+	0b0011111111111111111100, // ..@@@@@@@@@@@@@@@@@@..
+	0b0111111111111111111110, // .@@@@@@@@@@@@@@@@@@@@.
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+	0b1111111000000001111111, // @@@@@@@........@@@@@@@
+	0b1111110000000000111111, // @@@@@@..........@@@@@@
+	0b1111100000000000011111, // @@@@@............@@@@@
+	0b1111100000000000011111  // @@@@@............@@@@@
+};
+
+const ShieldDamage SHIELD_DAMAGE_SHOT =
+{
+	7, 7, 3, 3,
+	{
+		0b0101010, // .@.@.@.
+		0b0011100, // ..@@@..
+		0b0111110, // .@@@@@.
+		0b1111111, // @@@@@@@
+		0b0111110, // .@@@@@.
+		0b0011100, // ..@@@..
+		0b0101010, // .@.@.@.
+	}
+};
+
+// Bits of columns [begin, end), both within the shield
+static uint32_t column_mask(int32_t begin, int32_t end)
+{
+	uint32_t bits = (uint32_t(1) << (end - begin)) - 1;
+	return bits << (SHIELD_WIDTH - end);
+}
+
+void shields_init(Shield* shields, size_t width)
+{
+	// Same margin on both sides as between the shields
+	int32_t margin = (static_cast<int32_t>(width) - static_cast<int32_t>(SHIELD_COUNT) * SHIELD_WIDTH) /
+		static_cast<int32_t>(SHIELD_COUNT + 1);
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		Shield& shield = shields[i];
+		shield.x = margin + static_cast<int32_t>(i) * (SHIELD_WIDTH + margin);
+		shield.y = SHIELD_Y;
+		for (int32_t r = 0; r < SHIELD_HEIGHT; r++)
+		{
+			shield.rows[r] = SHIELD_ROWS[SHIELD_HEIGHT - 1 - r];
+		}
+	}
+}
+
+size_t shields_hit(const Shield* shields, const CollisionBox& box, int32_t* x, int32_t* y)
+{
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		const Shield& shield = shields[i];
+		int32_t x0 = box.x - shield.x;
+		int32_t x1 = x0 + box.width;
+		int32_t y0 = box.y - shield.y;
+		int32_t y1 = y0 + box.height;
+		if (x1 <= 0 || x0 >= SHIELD_WIDTH || y1 <= 0 || y0 >= SHIELD_HEIGHT) continue;
+
+		if (x0 < 0) x0 = 0;
+		if (x1 > SHIELD_WIDTH) x1 = SHIELD_WIDTH;
+		if (y0 < 0) y0 = 0;
+		if (y1 > SHIELD_HEIGHT) y1 = SHIELD_HEIGHT;
+
+		uint32_t mask = column_mask(x0, x1);
+		for (int32_t r = y0; r < y1; r++)
+		{
+			uint32_t hit = shield.rows[r] & mask;
+			if (!hit) continue;
+
+			// Leftmost pixel of the row is the highest bit
+			*x = SHIELD_WIDTH - 32 + std::countl_zero(hit);
+			*y = r;
+			return i;
+		}
+	}
+
+	return SHIELD_COUNT;
+}
+
+void shield_erode(Shield* shield, int32_t x, int32_t y, const ShieldDamage& damage)
+{
+	// Lines the pattern's center column up with column x
+	int32_t shift = SHIELD_WIDTH - damage.width + damage.center_x - x;
+	for (int32_t dy = 0; dy < damage.height; dy++)
+	{
+		// Pattern rows go top down, shield rows bottom up
+		int32_t r = y + damage.center_y - dy;
+		if (r < 0 || r >= SHIELD_HEIGHT) continue;
+
+		uint32_t bits = damage.rows[dy];
+		uint32_t shifted = shift >= 0 ? bits << shift : bits >> -shift;
+		shield->rows[r] &= ~shifted;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Collision.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// The four destructible shields between the player and the aliens. Each
+// is a bit-packed bitmap, one word per pixel row with bit
+// SHIELD_WIDTH - 1 - x for column x, so row literals read left to right.
+// Hit tests AND a row with a column mask and impacts AND-NOT a shifted
+// damage pattern, a few word operations either way.
+
+const size_t SHIELD_COUNT = 4;
+const int32_t SHIELD_WIDTH = 22;
+const int32_t SHIELD_HEIGHT = 16;
+const int32_t SHIELD_Y = 48;
+
+struct Shield
+{
+	int32_t x, y;
+	uint32_t rows[SHIELD_HEIGHT];  // Bottom row first
+};
+
+// Pixels knocked out around an impact, centered on (center_x, center_y)
+struct ShieldDamage
+{
+	int32_t width, height;
+	int32_t center_x, center_y;
+	uint32_t rows[8];              // Top row first, bit width - 1 - x for column x
+};
+
+extern const ShieldDamage SHIELD_DAMAGE_SHOT;
+
+// Spreads the shields evenly over a screen width wide
+void shields_init(Shield* shields, size_t width);
+
+// Finds the first shield pixel box overlaps, lowest row first. Returns
+// the shield index, or SHIELD_COUNT if box hits nothing, with the pixel
+// in shield coordinates in x and y.
+size_t shields_hit(const Shield* shields, const CollisionBox& box, int32_t* x, int32_t* y);
+
+void shield_erode(Shield* shield, int32_t x, int32_t y, const ShieldDamage& damage);
@@ -0,0 +1,356 @@
+#include "Snapshot.hpp"
+
+#include "File.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+static const char SNAPSHOT_MAGIC[4] = { 'S', 'I', 'S', 'S' };
+
+// The layout must not depend on the compiler's padding rules
+static_assert(sizeof(SnapshotArchetype) == 8 + 8 * COMPONENT_COUNT + 8, "SnapshotArchetype has padding");
+static_assert(sizeof(SnapshotHeader) ==
+	16 + 8 * 10 + sizeof(Random) + 8 * 3 + 4 * 2 + 4 * (COMPONENT_COUNT + ALIEN_ANIMATION_MAX + 3) + 4 * SHIELD_COUNT * SHIELD_HEIGHT,
+	"SnapshotHeader has padding");
+static_assert(sizeof(SnapshotHeader) % 8 == 0 && sizeof(Random) == 16, "Snapshot arrays must stay 8-byte aligned");
+
+static size_t align8(size_t size)
+{
+	return (size + 7) & ~static_cast<size_t>(7);
+}
+
+size_t snapshot_size(const Game& game, bool padded)
+{
+	const World& world = game.world;
+	size_t size = sizeof(SnapshotHeader) + world.num_archetypes * sizeof(SnapshotArchetype);
+	for (size_t a = 0; a < world.num_archetypes; a++)
+	{
+		const Archetype& archetype = world.archetypes[a];
+		size_t rows = padded ? archetype.capacity : archetype.count;
+		size += align8(rows * sizeof(Entity));
+		for (size_t c = 0; c < COMPONENT_COUNT; c++)
+		{
+			if (archetype.mask & component_bit(c)) size += align8(rows * COMPONENT_SIZES[c]);
+		}
+	}
+
+	size_t entities = padded ? world.entity_capacity : world.num_entities;
+	size_t free_entities = padded ? world.entity_capacity : world.num_free_entities;
+	size += align8(entities * sizeof(EntityLocation));
+	size += align8(entities * sizeof(uint8_t));
+	size += align8(free_entities * sizeof(uint32_t));
+	return size;
+}
+
+// Copies size bytes to data + *offset, zero filling up to reserved bytes,
+// and returns where they went
+static uint64_t write_array(uint8_t* data, size_t* offset, const void* source, size_t size, size_t reserved)
+{
+	size_t at = *offset;
+	if (size) memcpy(data + at, source, size);
+	memset(data + at + size, 0, align8(reserved) - size);
+	*offset = at + align8(reserved);
+	return at;
+}
+
+void snapshot_write(const Game& game, uint8_t* data, bool padded)
+{
+	const World& world = game.world;
+
+	SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(data);
+	memset(header, 0, sizeof(SnapshotHeader));
+	memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header->version = SNAPSHOT_VERSION;
+	header->size = snapshot_size(game, padded);
+
+	header->formation_columns = game.config.formation_columns;
+	header->formation_rows = game.config.formation_rows;
+	header->num_aliens = game.config.num_aliens;
+	header->max_bullets = game.config.max_bullets;
+	header->fire_rate = game.config.fire_rate;
+	header->seed = game.config.seed;
+	header->width = game.width;
+	header->height = game.height;
+
+	header->score = game.score;
+	header->tick = game.tick;
+	header->wave = game.wave;
+	header->random = game.random;
+
+	for (size_t c = 0; c < COMPONENT_COUNT; c++)
+	{
+		header->component_sizes[c] = static_cast<uint32_t>(COMPONENT_SIZES[c]);
+	}
+	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	{
+		header->animation_time[i] = static_cast<uint32_t>(game.alien_animation[i].time);
+	}
+	header->player = game.player;
+	header->num_archetypes = static_cast<uint32_t>(world.num_archetypes);
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		memcpy(header->shield_rows[i], game.shields[i].rows, sizeof(header->shield_rows[i]));
+	}
+
+	SnapshotArchetype* archetypes = reinterpret_cast<SnapshotArchetype*>(data + sizeof(SnapshotHeader));
+	size_t offset = sizeof(SnapshotHeader) + world.num_archetypes * sizeof(SnapshotArchetype);
+	for (size_t a = 0; a < world.num_archetypes; a++)
+	{
+		const Archetype& archetype = world.archetypes[a];
+		SnapshotArchetype& out = archetypes[a];
+		memset(&out, 0, sizeof(out));
+		out.mask = archetype.mask;
+		out.count = static_cast<uint32_t>(archetype.count);
+		size_t rows = padded ? archetype.capacity : archetype.count;
+		out.entities_offset = write_array(data, &offset, archetype.entities,
+			archetype.count * sizeof(Entity), rows * sizeof(Entity));
+		for (size_t c = 0; c < COMPONENT_COUNT; c++)
+		{
+			if (!(archetype.mask & component_bit(c))) continue;
+			out.column_offsets[c] = write_array(data, &offset, archetype.columns[c],
+				archetype.count * COMPONENT_SIZES[c], rows * COMPONENT_SIZES[c]);
+		}
+	}
+
+	header->num_entities = static_cast<uint32_t>(world.num_entities);
+	header->num_free_entities = static_cast<uint32_t>(world.num_free_entities);
+	size_t entities = padded ? world.entity_capacity : world.num_entities;
+	size_t free_entities = padded ? world.entity_capacity : world.num_free_entities;
+	header->locations_offset = write_array(data, &offset, world.locations,
+		world.num_entities * sizeof(EntityLocation), entities * sizeof(EntityLocation));
+	header->generations_offset = write_array(data, &offset, world.generations,
+		world.num_entities * sizeof(uint8_t), entities * sizeof(uint8_t));
+	header->free_entities_offset = write_array(data, &offset, world.free_entities,
+		world.num_free_entities * sizeof(uint32_t), free_entities * sizeof(uint32_t));
+}
+
+static bool range_valid(uint64_t offset, uint64_t size, uint64_t total)
+{
+	return offset <= total && size <= total - offset;
+}
+
+static GameConfig snapshot_header_config(const SnapshotHeader& header)
+{
+	GameConfig config;
+	config.formation_columns = static_cast<size_t>(header.formation_columns);
+	config.formation_rows = static_cast<size_t>(header.formation_rows);
+	config.num_aliens = static_cast<size_t>(header.num_aliens);
+	config.max_bullets = static_cast<size_t>(header.max_bullets);
+	config.fire_rate = static_cast<size_t>(header.fire_rate);
+	config.seed = header.seed;
+	return config;
+}
+
+// Whether the live rows and the entity table agree: each row's entity is
+// current and located at that row, and every entity is either in a row or
+// free. Locations of free entities are stale but have to stay within the
+// reserved rows.
+static bool snapshot_entities_valid(const uint8_t* data, const SnapshotHeader* header, const GameConfig& config)
+{
+	const SnapshotArchetype* archetypes = reinterpret_cast<const SnapshotArchetype*>(data + sizeof(SnapshotHeader));
+	const EntityLocation* locations = reinterpret_cast<const EntityLocation*>(data + header->locations_offset);
+	const uint8_t* generations = data + header->generations_offset;
+	const uint32_t* free_entities = reinterpret_cast<const uint32_t*>(data + header->free_entities_offset);
+
+	for (size_t i = 0; i < header->num_entities; i++)
+	{
+		const EntityLocation& location = locations[i];
+		if (location.archetype >= header->num_archetypes) return false;
+		if (location.row >= game_archetype_capacity(config, archetypes[location.archetype].mask)) return false;
+	}
+
+	uint64_t num_rows = 0;
+	for (size_t a = 0; a < header->num_archetypes; a++)
+	{
+		const Entity* entities = reinterpret_cast<const Entity*>(data + archetypes[a].entities_offset);
+		for (size_t row = 0; row < archetypes[a].count; row++)
+		{
+			size_t index = entities[row] & 0xFFFFFF;
+			if (index >= header->num_entities || generations[index] != entities[row] >> 24) return false;
+			if (locations[index].archetype != a || locations[index].row != row) return false;
+		}
+		num_rows += archetypes[a].count;
+	}
+	if (num_rows + header->num_free_entities != header->num_entities) return false;
+
+	for (size_t i = 0; i < header->num_free_entities; i++)
+	{
+		if (free_entities[i] >= header->num_entities) return false;
+	}
+
+	// The player has to be a live entity with the player's components
+	size_t player = header->player & 0xFFFFFF;
+	if (player >= header->num_entities || generations[player] != header->player >> 24) return false;
+	const EntityLocation& location = locations[player];
+	const SnapshotArchetype& archetype = archetypes[location.archetype];
+	return (archetype.mask & PLAYER_COMPONENTS) == PLAYER_COMPONENTS && location.row < archetype.count;
+}
+
+// Whether every alien has a slot in the formation
+static bool snapshot_formation_valid(const uint8_t* data, const SnapshotHeader* header, const GameConfig& config)
+{
+	const SnapshotArchetype* archetypes = reinterpret_cast<const SnapshotArchetype*>(data + sizeof(SnapshotHeader));
+	size_t num_slots = config.formation_columns * config.formation_rows;
+	for (size_t a = 0; a < header->num_archetypes; a++)
+	{
+		if ((archetypes[a].mask & ALIEN_COMPONENTS) != ALIEN_COMPONENTS) continue;
+
+		const FormationSlot* slots =
+			reinterpret_cast<const FormationSlot*>(data + archetypes[a].column_offsets[COMPONENT_FORMATION_SLOT]);
+		for (size_t row = 0; row < archetypes[a].count; row++)
+		{
+			if (slots[row].index >= num_slots) return false;
+		}
+	}
+	return true;
+}
+
+// Checks everything restore relies on, without touching any game: the
+// arrays lie within data, the config is one game_init() accepts, no count
+// exceeds what that config reserves, and every index is in range
+static const SnapshotHeader* snapshot_validate(const uint8_t* data, size_t size)
+{
+	if (size < sizeof(SnapshotHeader)) return nullptr;
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data);
+	if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return nullptr;
+	if (header->version != SNAPSHOT_VERSION || header->size != size) return nullptr;
+
+	for (size_t c = 0; c < COMPONENT_COUNT; c++)
+	{
+		if (header->component_sizes[c] != COMPONENT_SIZES[c]) return nullptr;
+	}
+
+	GameConfig config = snapshot_header_config(*header);
+	if (!game_config_valid(config)) return nullptr;
+
+	if (header->num_archetypes > ECS_MAX_ARCHETYPES) return nullptr;
+	if (!range_valid(sizeof(SnapshotHeader), header->num_archetypes * sizeof(SnapshotArchetype), size)) return nullptr;
+
+	const SnapshotArchetype* archetypes = reinterpret_cast<const SnapshotArchetype*>(data + sizeof(SnapshotHeader));
+	for (size_t a = 0; a < header->num_archetypes; a++)
+	{
+		const SnapshotArchetype& archetype = archetypes[a];
+		if (archetype.mask >> COMPONENT_COUNT) return nullptr;
+		if (archetype.count > game_archetype_capacity(config, archetype.mask)) return nullptr;
+		if (!range_valid(archetype.entities_offset, archetype.count * sizeof(Entity), size)) return nullptr;
+		for (size_t c = 0; c < COMPONENT_COUNT; c++)
+		{
+			if (!(archetype.mask & component_bit(c))) continue;
+			if (!range_valid(archetype.column_offsets[c], archetype.count * COMPONENT_SIZES[c], size)) return nullptr;
+		}
+	}
+
+	if (header->num_entities > game_entity_capacity(config)) return nullptr;
+	if (header->num_free_entities > header->num_entities) return nullptr;
+	if (!range_valid(header->locations_offset, header->num_entities * sizeof(EntityLocation), size) ||
+		!range_valid(header->generations_offset, header->num_entities * sizeof(uint8_t), size) ||
+		!range_valid(header->free_entities_offset, header->num_free_entities * sizeof(uint32_t), size))
+	{
+		return nullptr;
+	}
+
+	if (!snapshot_entities_valid(data, header, config) || !snapshot_formation_valid(data, header, config)) return nullptr;
+
+	return header;
+}
+
+bool snapshot_config(const uint8_t* data, size_t size, GameConfig* config)
+{
+	const SnapshotHeader* header = snapshot_validate(data, size);
+	if (!header) return false;
+
+	*config = snapshot_header_config(*header);
+	return true;
+}
+
+bool snapshot_restore(Game* game, const uint8_t* data, size_t size)
+{
+	const SnapshotHeader* header = snapshot_validate(data, size);
+	if (!header) return false;
+
+	const GameConfig& config = game->config;
+	if (header->formation_columns != config.formation_columns || header->formation_rows != config.formation_rows ||
+		header->num_aliens != config.num_aliens || header->max_bullets != config.max_bullets ||
+		header->fire_rate != config.fire_rate || header->seed != config.seed ||
+		header->width != game->width || header->height != game->height)
+	{
+		return false;
+	}
+
+	// game_init() creates the archetypes in the same order for every game
+	// with this config and reserves all their rows, so they have to line up.
+	// Validation kept every count within the reservation, so nothing grows.
+	World* world = &game->world;
+	const SnapshotArchetype* archetypes = reinterpret_cast<const SnapshotArchetype*>(data + sizeof(SnapshotHeader));
+	if (header->num_archetypes > world->num_archetypes) return false;
+	for (size_t a = 0; a < header->num_archetypes; a++)
+	{
+		if (world->archetypes[a].mask != archetypes[a].mask) return false;
+	}
+
+	for (size_t a = 0; a < header->num_archetypes; a++)
+	{
+		const SnapshotArchetype& from = archetypes[a];
+		Archetype* archetype = &world->archetypes[a];
+
+		ecs_reserve(world, archetype, from.count);
+		memcpy(archetype->entities, data + from.entities_offset, from.count * sizeof(Entity));
+		for (size_t c = 0; c < COMPONENT_COUNT; c++)
+		{
+			if (!(from.mask & component_bit(c))) continue;
+			memcpy(archetype->columns[c], data + from.column_offsets[c], from.count * COMPONENT_SIZES[c]);
+		}
+
+		memset(archetype->alive, 0xFF, (from.count + 7) / 8);
+		archetype->count = from.count;
+		archetype->num_spawned = 0;
+		archetype->has_despawns = false;
+	}
+
+	// Archetypes created after the snapshot was taken are left empty
+	for (size_t a = header->num_archetypes; a < world->num_archetypes; a++)
+	{
+		world->archetypes[a].count = 0;
+		world->archetypes[a].num_spawned = 0;
+		world->archetypes[a].has_despawns = false;
+	}
+
+	ecs_reserve_entities(world, header->num_entities);
+	memcpy(world->locations, data + header->locations_offset, header->num_entities * sizeof(EntityLocation));
+	memcpy(world->generations, data + header->generations_offset, header->num_entities * sizeof(uint8_t));
+	memcpy(world->free_entities, data + header->free_entities_offset, header->num_free_entities * sizeof(uint32_t));
+	world->num_entities = header->num_entities;
+	world->num_free_entities = header->num_free_entities;
+
+	game->score = header->score;
+	game->tick = header->tick;
+	game->wave = header->wave;
+	game->random = header->random;
+	for (size_t i = 0; i < ALIEN_ANIMATION_MAX; i++)
+	{
+		game->alien_animation[i].time = header->animation_time[i];
+	}
+	game->player = header->player;
+	for (size_t i = 0; i < SHIELD_COUNT; i++)
+	{
+		memcpy(game->shields[i].rows, header->shield_rows[i], sizeof(game->shields[i].rows));
+	}
+	game_rebuild_formation(game);
+
+	return true;
+}
+
+bool snapshot_save(const Game& game, const char* path)
+{
+	size_t size = snapshot_size(game);
+	uint8_t* data = new uint8_t[size];
+	snapshot_write(game, data);
+
+	bool ok = file_write(path, data, size);
+
+	delete[] data;
+
+	if (!ok) fprintf(stderr, "Failed to write snapshot %s\n", path);
+	return ok;
+}
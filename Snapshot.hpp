@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Flat snapshot of the simulation state. A snapshot is one contiguous,
+// pointer-free block: a fixed header, one SnapshotArchetype per archetype,
+// then the raw arrays they point at by offset, each 8-byte aligned. It is
+// written with a single write and restored straight out of a file mapping
+// by copying the arrays back into the ECS; nothing is decoded. Integers are
+// stored in the native (little-endian) byte order.
+
+const uint32_t SNAPSHOT_VERSION = 3;
+
+struct SnapshotArchetype
+{
+	uint64_t entities_offset;
+	uint64_t column_offsets[COMPONENT_COUNT];
+	uint32_t mask;
+	uint32_t count;
+};
+
+struct SnapshotHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t size;
+
+	uint64_t formation_columns, formation_rows;
+	uint64_t num_aliens, max_bullets, fire_rate, seed;
+	uint64_t width, height;
+
+	uint64_t score, tick;
+	Random random;
+
+	uint64_t locations_offset;
+	uint64_t generations_offset;
+	uint64_t free_entities_offset;
+	uint32_t num_entities, num_free_entities;
+
+	uint32_t component_sizes[COMPONENT_COUNT];
+	uint32_t animation_time[ALIEN_ANIMATION_MAX];
+	uint32_t player;
+	uint32_t num_archetypes;
+	uint32_t wave;
+
+	uint32_t shield_rows[SHIELD_COUNT][SHIELD_HEIGHT];
+};
+
+// Bytes needed to snapshot game in its current state. A padded snapshot
+// reserves every array at its capacity, zero filled, so array offsets stay
+// put from tick to tick. That lines snapshots up for diffing.
+size_t snapshot_size(const Game& game, bool padded = false);
+
+// Writes snapshot_size(game, padded) bytes into data. Call between ticks.
+void snapshot_write(const Game& game, uint8_t* data, bool padded = false);
+
+// Reads the config a snapshot was taken with. Returns false if data is not
+// a valid snapshot for this build.
+bool snapshot_config(const uint8_t* data, size_t size, GameConfig* config);
+
+// Overwrites the state of game, which must have been created with the
+// snapshot's config. Returns false if the snapshot does not fit.
+bool snapshot_restore(Game* game, const uint8_t* data, size_t size);
+
+// Saves to path through a temporary file so a crash never leaves a torn
+// snapshot behind. Snapshots are read back with file_map() (File.hpp).
+bool snapshot_save(const Game& game, const char* path);
@@ -0,0 +1,149 @@
+#include "SpaceInvadersApi.h"
+
+#include "Batch.hpp"
+#include "Buffer.hpp"
+#include "Game.hpp"
+#include "Observation.hpp"
+
+#include <new>
+
+static_assert(SI_FRAME_WIDTH == BUFFER_WIDTH && SI_FRAME_HEIGHT == BUFFER_HEIGHT);
+static_assert(SI_POOLING_MAX == static_cast<int>(POOLING_MAX));
+static_assert(SI_ACTION_RIGHT_FIRE == static_cast<int>(ACTION_RIGHT_FIRE) && SI_ACTION_COUNT == static_cast<int>(ACTION_COUNT));
+
+struct SiGame
+{
+	Game game;
+
+	// Frames go to buffer.data, which is either own_pixels or caller memory
+	Buffer buffer;
+	uint32_t* own_pixels;
+	bool frame_current;
+
+	// Set up by the last si_get_observation(), width 0 before
+	Observer observer;
+};
+
+extern "C" {
+
+uint32_t si_api_version(void)
+{
+	return SI_API_VERSION;
+}
+
+SiGame* si_create(uint64_t seed)
+{
+	SiGame* handle = new (std::nothrow) SiGame();
+	if (!handle) return nullptr;
+
+	// The engine allocates with new[], keep exceptions from crossing the ABI
+	try
+	{
+		GameConfig config = game_default_config();
+		config.seed = seed;
+
+		game_init(&handle->game, config, &SPRITES, BUFFER_WIDTH, BUFFER_HEIGHT);
+
+		handle->own_pixels = new uint32_t[BUFFER_WIDTH * BUFFER_HEIGHT];
+		handle->buffer = { BUFFER_WIDTH, BUFFER_HEIGHT, handle->own_pixels };
+		handle->frame_current = false;
+	}
+	catch (const std::bad_alloc&)
+	{
+		si_destroy(handle);
+		return nullptr;
+	}
+
+	return handle;
+}
+
+void si_destroy(SiGame* handle)
+{
+	if (!handle) return;
+
+	// Only free what si_create() got to, the rest is still zero
+	if (handle->game.sprites) game_free(&handle->game);
+	delete[] handle->own_pixels;
+	observer_free(&handle->observer);
+	delete handle;
+}
+
+void si_reset(SiGame* handle, uint64_t seed)
+{
+	Game* game = &handle->game;
+	game_reset(game);
+	random_seed(&game->random, seed);
+	handle->frame_current = false;
+}
+
+int32_t si_step(SiGame* handle, int32_t action, int32_t* done)
+{
+	Game* game = &handle->game;
+	uint64_t score = game->score;
+	uint32_t wave = game->wave;
+	uint8_t checked = action >= 0 && action < SI_ACTION_COUNT ? static_cast<uint8_t>(action) : uint8_t(ACTION_NONE);
+	game_simulate(game, action_input(checked));
+	handle->frame_current = false;
+
+	if (done) *done = game->wave != wave;
+	return static_cast<int32_t>(game->score - score);
+}
+
+uint64_t si_get_score(const SiGame* handle)
+{
+	return handle->game.score;
+}
+
+uint32_t si_get_lives(const SiGame* handle)
+{
+	const Game& game = handle->game;
+	if (game.players->count == 0) return 0;
+	return ecs_column<Player>(game.players, COMPONENT_PLAYER)[0].life;
+}
+
+uint64_t si_get_tick(const SiGame* handle)
+{
+	return handle->game.tick;
+}
+
+const uint32_t* si_get_framebuffer(SiGame* handle)
+{
+	if (!handle->frame_current)
+	{
+		buffer_draw_game(&handle->buffer, handle->game, rgb_to_uint32(0, 128, 0));
+		handle->frame_current = true;
+	}
+	return handle->buffer.data;
+}
+
+int32_t si_get_observation(
+	SiGame* handle, uint8_t* pixels, uint32_t width, uint32_t height, int32_t pooling)
+{
+	Observer* observer = &handle->observer;
+	if (pooling < 0 || pooling >= POOLING_COUNT) return 0;
+	if (observer->width != width || observer->height != height || observer->pooling != static_cast<Pooling>(pooling))
+	{
+		observer_free(observer);
+		try
+		{
+			if (!observer_init(observer, width, height, static_cast<Pooling>(pooling), BUFFER_WIDTH, BUFFER_HEIGHT)) return 0;
+		}
+		catch (const std::bad_alloc&)
+		{
+			observer_free(observer);
+			return 0;
+		}
+	}
+
+	si_get_framebuffer(handle);
+	observe_buffer(observer, handle->buffer, pixels);
+	return 1;
+}
+
+void si_set_framebuffer(SiGame* handle, uint32_t* pixels)
+{
+	handle->buffer.data = pixels ? pixels : handle->own_pixels;
+	handle->frame_current = false;
+}
+
+}
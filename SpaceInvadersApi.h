@@ -0,0 +1,95 @@
+#pragma once
+
+/*
+ * Plain C interface to the simulation, built as the SpaceInvadersLib
+ * shared library. Everything goes through an opaque SiGame handle; one
+ * handle must not be used from two threads at once, separate handles
+ * are independent.
+ *
+ * Frames are SI_FRAME_WIDTH x SI_FRAME_HEIGHT pixels of 0xRRGGBBAA,
+ * row 0 at the bottom of the screen. They are rendered straight into
+ * either the library's own framebuffer or memory supplied by the
+ * caller, never copied.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+	#if defined(SI_BUILD_DLL)
+		#define SI_API __declspec(dllexport)
+	#else
+		#define SI_API __declspec(dllimport)
+	#endif
+#else
+	#define SI_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a signature or the meaning of a value changes */
+#define SI_API_VERSION 1
+
+#define SI_FRAME_WIDTH 224
+#define SI_FRAME_HEIGHT 256
+
+/* Same values as the Action enum used by the batch environment */
+enum
+{
+	SI_ACTION_NONE = 0,
+	SI_ACTION_LEFT = 1,
+	SI_ACTION_RIGHT = 2,
+	SI_ACTION_FIRE = 3,
+	SI_ACTION_LEFT_FIRE = 4,
+	SI_ACTION_RIGHT_FIRE = 5,
+	SI_ACTION_COUNT = 6
+};
+
+/* Pooling modes for si_get_observation() */
+enum
+{
+	SI_POOLING_NEAREST = 0,
+	SI_POOLING_AVERAGE = 1,
+	SI_POOLING_MAX = 2
+};
+
+typedef struct SiGame SiGame;
+
+SI_API uint32_t si_api_version(void);
+
+/* Returns null if out of memory */
+SI_API SiGame* si_create(uint64_t seed);
+SI_API void si_destroy(SiGame* game);
+
+/* Starts a new episode from the initial state. Does not allocate. */
+SI_API void si_reset(SiGame* game, uint64_t seed);
+
+/* Advances one tick and returns the score gained. Unknown actions do
+ * nothing. *done, if not null, is set to 1 on the step that clears the
+ * wave; stepping on plays the next one. */
+SI_API int32_t si_step(SiGame* game, int32_t action, int32_t* done);
+
+SI_API uint64_t si_get_score(const SiGame* game);
+SI_API uint32_t si_get_lives(const SiGame* game);
+SI_API uint64_t si_get_tick(const SiGame* game);
+
+/* Renders the current tick if it has not been yet and returns the frame.
+ * The pointer stays valid until si_set_framebuffer() or si_destroy(). */
+SI_API const uint32_t* si_get_framebuffer(SiGame* game);
+
+/* Makes frames render into pixels, which must hold SI_FRAME_WIDTH *
+ * SI_FRAME_HEIGHT values and outlive its use. Null switches back to the
+ * library's own framebuffer. */
+SI_API void si_set_framebuffer(SiGame* game, uint32_t* pixels);
+
+/* Downsamples the current frame to a width x height grayscale image, one
+ * byte per pixel with row 0 at the top, written to pixels. Changing the
+ * size or pooling mode allocates; repeated calls with the same ones do
+ * not. Returns 0 if the size or mode is unsupported. */
+SI_API int32_t si_get_observation(
+	SiGame* game, uint8_t* pixels, uint32_t width, uint32_t height, int32_t pooling);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Sprites drawn as ASCII art and turned into pixel tables by the compiler,
+// one string per row, '@' for a set pixel and '.' for a clear one:
+//
+//   constexpr SpritePixels<3, 2> ARROW = sprite_art<3, 2>(
+//       ".@.",
+//       "@@@"
+//   );
+//
+// A row of the wrong width, the wrong number of rows or any other character
+// fails to compile, so a drawing can never drift from its data.
+
+template<size_t Width, size_t Height>
+struct SpritePixels
+{
+	uint8_t data[Width * Height];
+};
+
+// A sheet of Frames equally sized frames, drawn Columns to a row with a
+// space between them. The frames come out stacked top to bottom, frame by
+// frame in reading order.
+template<size_t Width, size_t Height, size_t Frames, size_t Columns, size_t... Lengths>
+consteval SpritePixels<Width, Height * Frames> sprite_sheet_art(const char (&... rows)[Lengths])
+{
+	static_assert(Frames % Columns == 0, "sprite sheet must fill its last row of frames");
+	static_assert(sizeof...(Lengths) == Height * (Frames / Columns), "sprite art has the wrong number of rows");
+	static_assert(((Lengths == Columns * (Width + 1)) && ...), "sprite art row has the wrong width");
+
+	SpritePixels<Width, Height * Frames> pixels = {};
+	size_t y = 0;
+	auto parse_row = [&](const char* row)
+	{
+		size_t first_frame = y / Height * Columns;
+		for (size_t column = 0; column < Columns; column++)
+		{
+			const char* line = row + column * (Width + 1);
+			uint8_t* out = pixels.data + ((first_frame + column) * Height + y % Height) * Width;
+			for (size_t x = 0; x < Width; x++)
+			{
+				if (line[x] == '@') out[x] = 1;
+				else if (line[x] != '.') throw "sprite art pixels must be '@' or '.'";
+			}
+			if (column + 1 < Columns && line[Width] != ' ') throw "sprite sheet frames must be one space apart";
+		}
+		y++;
+	};
+	(parse_row(rows), ...);
+	return pixels;
+}
+
+template<size_t Width, size_t Height, size_t... Lengths>
+consteval SpritePixels<Width, Height> sprite_art(const char (&... rows)[Lengths])
+{
+	return sprite_sheet_art<Width, Height, 1, 1>(rows...);
+}
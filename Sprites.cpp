@@ -0,0 +1,160 @@
+#include "Sprites.hpp"
+
+#include "SpriteArt.hpp"
+
+// Two animation frames for each of the three alien types
+static constexpr SpritePixels<8, 8> ALIEN_A0 = sprite_art<8, 8>(
+	"...@@...",
+	"..@@@@..",
+	".@@@@@@.",
+	"@@.@@.@@",
+	"@@@@@@@@",
+	".@.@@.@.",
+	"@......@",
+	".@....@."
+);
+
+static constexpr SpritePixels<8, 8> ALIEN_A1 = sprite_art<8, 8>(
+	"...@@...",
+	"..@@@@..",
+	".@@@@@@.",
+	"@@.@@.@@",
+	"@@@@@@@@",
+	"..@..@..",
+	".@.@@.@.",
+	"@.@..@.@"
+);
+
+static constexpr SpritePixels<11, 8> ALIEN_B0 = sprite_art<11, 8>(
+	"..@.....@..",
+	"...@...@...",
+	"..@@@@@@@..",
+	".@@.@@@.@@.",
+	"@@@@@@@@@@@",
+	"@.@@@@@@@.@",
+	"@.@.....@.@",
+	"...@@.@@..."
+);
+
+static constexpr SpritePixels<11, 8> ALIEN_B1 = sprite_art<11, 8>(
+	"..@.....@..",
+	"@..@...@..@",
+	"@.@@@@@@@.@",
+	"@@@.@@@.@@@",
+	"@@@@@@@@@@@",
+	".@@@@@@@@@.",
+	"..@.....@..",
+	".@.......@."
+);
+
+static constexpr SpritePixels<12, 8> ALIEN_C0 = sprite_art<12, 8>(
+	"....@@@@....",
+	".@@@@@@@@@@.",
+	"@@@@@@@@@@@@",
+	"@@@..@@..@@@",
+	"@@@@@@@@@@@@",
+	"...@@..@@...",
+	"..@@.@@.@@..",
+	"@@........@@"
+);
+
+static constexpr SpritePixels<12, 8> ALIEN_C1 = sprite_art<12, 8>(
+	"....@@@@....",
+	".@@@@@@@@@@.",
+	"@@@@@@@@@@@@",
+	"@@@..@@..@@@",
+	"@@@@@@@@@@@@",
+	"..@@@..@@@..",
+	".@@..@@..@@.",
+	"..@@....@@.."
+);
+
+static constexpr SpritePixels<13, 7> ALIEN_DEATH = sprite_art<13, 7>(
+	".@..@...@..@.",
+	"..@..@.@..@..",
+	"...@.....@...",
+	"@@.........@@",
+	"...@.....@...",
+	"..@..@.@..@..",
+	".@..@...@..@."
+);
+
+static constexpr SpritePixels<11, 7> PLAYER = sprite_art<11, 7>(
+	".....@.....",
+	"....@@@....",
+	"....@@@....",
+	".@@@@@@@@@.",
+	"@@@@@@@@@@@",
+	"@@@@@@@@@@@",
+	"@@@@@@@@@@@"
+);
+
+static constexpr SpritePixels<1, 3> BULLET = sprite_art<1, 3>(
+	"@",
+	"@",
+	"@"
+);
+
+// Characters ' ' to '`', 13 glyphs to a row
+static constexpr SpritePixels<5, 7 * GLYPH_COUNT> GLYPHS = sprite_sheet_art<5, 7, GLYPH_COUNT, 13>(
+	//       !     "     #     $     %     &     '     (     )     *     +     ,
+	"..... ..@.. .@.@. .@.@. ..@.. @@.@. .@@.. ...@. ....@ @.... ..@.. ..... .....",
+	"..... ..@.. .@.@. .@.@. .@@@. @@.@. @..@. ..@.. ...@. .@... @.@.@ ..@.. .....",
+	"..... ..@.. ..... @@@@@ @.@.. ..@.. @..@. ..... ..@.. ..@.. .@@@. ..@.. .....",
+	"..... ..@.. ..... .@.@. .@@@. ..@.. .@@.. ..... ..@.. ..@.. ..@.. @@@@@ .....",
+	"..... ..@.. ..... @@@@@ ..@.@ ..@.. @..@. ..... ..@.. ..@.. .@@@. ..@.. .....",
+	"..... ..... ..... .@.@. .@@@. .@.@@ @...@ ..... ...@. .@... @.@.@ ..@.. ..@..",
+	"..... ..@.. ..... .@.@. ..@.. .@.@@ .@@@@ ..... ....@ @.... ..@.. ..... ..@..",
+	// -     .     /     0     1     2     3     4     5     6     7     8     9
+	"..... ..... ...@. .@@@. ..@.. .@@@. @@@@@ ...@. @@@@@ .@@@. @@@@@ .@@@. .@@@.",
+	"..... ..... ...@. @...@ .@@.. @...@ ....@ ..@@. @.... @...@ ....@ @...@ @...@",
+	"..... ..... ..@.. @..@@ ..@.. ....@ ...@. .@.@. @@@@. @.... ...@. @...@ @...@",
+	"@@@@@ ..... ..@.. @.@.@ ..@.. ..@@. ..@@. @..@. ....@ @@@@. ..@.. .@@@. .@@@@",
+	"..... ..... ..@.. @@..@ ..@.. .@... ....@ @@@@@ ....@ @...@ .@... @...@ ....@",
+	"..... ..... .@... @...@ ..@.. @.... @...@ ...@. @...@ @...@ .@... @...@ @...@",
+	"..... ..@.. .@... .@@@. .@@@. @@@@@ .@@@. ...@. .@@@. .@@@. .@... .@@@. .@@@.",
+	// :     ;     <     =     >     ?     @     A     B     C     D     E     F
+	"..... ..... ....@ ..... @.... .@@@. .@@@. ..@.. @@@@. .@@@. @@@@. @@@@@ @@@@@",
+	"..@.. ..@.. ...@. ..... .@... @...@ @...@ .@.@. @...@ @...@ @...@ @.... @....",
+	"..... ..... ..@.. @@@@@ ..@.. ...@. @.@.@ @...@ @...@ @.... @...@ @.... @....",
+	"..... ..... .@... ..... ...@. ..@.. @@.@@ @...@ @@@@. @.... @...@ @@@@. @@@@.",
+	"..... ..... ..@.. @@@@@ ..@.. ..@.. @.@.. @@@@@ @...@ @.... @...@ @.... @....",
+	"..@.. ..@.. ...@. ..... .@... ..... @...@ @...@ @...@ @...@ @...@ @.... @....",
+	"..... ..@.. ....@ ..... @.... ..@.. .@@@. @...@ @@@@. .@@@. @@@@. @@@@@ @....",
+	// G     H     I     J     K     L     M     N     O     P     Q     R     S
+	".@@@. @...@ .@@@. ....@ @...@ @.... @...@ @...@ .@@@. @@@@. .@@@. @@@@. .@@@.",
+	"@...@ @...@ ..@.. ....@ @..@. @.... @@.@@ @...@ @...@ @...@ @...@ @...@ @...@",
+	"@.... @...@ ..@.. ....@ @.@.. @.... @.@.@ @@..@ @...@ @...@ @...@ @...@ @....",
+	"@.@@@ @@@@@ ..@.. ....@ @@... @.... @.@.@ @.@.@ @...@ @@@@. @...@ @@@@. .@@@.",
+	"@...@ @...@ ..@.. ....@ @.@.. @.... @...@ @..@@ @...@ @.... @.@.@ @.@.. @...@",
+	"@...@ @...@ ..@.. @...@ @..@. @.... @...@ @...@ @...@ @.... @..@@ @..@. ....@",
+	".@@@. @...@ .@@@. .@@@. @...@ @@@@@ @...@ @...@ .@@@. @.... .@@@@ @...@ .@@@.",
+	// T     U     V     W     X     Y     Z     [     \     ]     ^     _     `
+	"@@@@@ @...@ @...@ @...@ @...@ @...@ @@@@@ ...@@ .@... @@... ..@.. ..... ..@..",
+	"..@.. @...@ @...@ @...@ @...@ @...@ ....@ ..@.. .@... ..@.. .@.@. ..... ...@.",
+	"..@.. @...@ @...@ @...@ .@.@. .@.@. ...@. ..@.. ..@.. ..@.. @...@ ..... .....",
+	"..@.. @...@ @...@ @.@.@ ..@.. ..@.. ..@.. ..@.. ..@.. ..@.. ..... ..... .....",
+	"..@.. @...@ @...@ @.@.@ .@.@. ..@.. .@... ..@.. ..@.. ..@.. ..... ..... .....",
+	"..@.. @...@ .@.@. @@.@@ @...@ ..@.. @.... ..@.. ...@. ..@.. ..... ..... .....",
+	"..@.. .@@@. ..@.. @...@ @...@ ..@.. @@@@@ ...@@ ...@. @@... ..... @@@@@ ....."
+);
+
+template<size_t Width, size_t Height>
+static constexpr Sprite sprite(const SpritePixels<Width, Height>& pixels, size_t frame_height = Height, size_t frame = 0)
+{
+	return { Width, frame_height, pixels.data + frame * Width * frame_height };
+}
+
+const Sprites SPRITES =
+{
+	{
+		sprite(ALIEN_A0), sprite(ALIEN_A1),
+		sprite(ALIEN_B0), sprite(ALIEN_B1),
+		sprite(ALIEN_C0), sprite(ALIEN_C1),
+	},
+	sprite(ALIEN_DEATH),
+	sprite(PLAYER),
+	sprite(GLYPHS, 7),
+	sprite(GLYPHS, 7, GLYPH_DIGITS),
+	sprite(BULLET),
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+const size_t ALIEN_SPRITES_MAX = 6;
+const size_t ALIEN_ANIMATION_MAX = 3;
+
+// The text sheet holds characters ' ' to '`', digits from '0' on
+const size_t GLYPH_COUNT = 65;
+const size_t GLYPH_DIGITS = '0' - ' ';
+
+struct Sprite
+{
+	size_t width, height;
+	const uint8_t* data;
+};
+
+struct SpriteAnimation
+{
+	bool loop;
+	size_t num_frames;
+	size_t frame_duration;
+	size_t time;
+	const Sprite* frames;   // num_frames consecutive sprites
+};
+
+struct Sprites
+{
+	Sprite aliens[ALIEN_SPRITES_MAX];
+	Sprite alien_death;
+	Sprite player;
+	Sprite text;            // GLYPH_COUNT glyphs, one after the other
+	Sprite numbers;         // The digits within text
+	Sprite bullet;
+};
+
+// Built in, compiled from ASCII art into read-only tables (Sprites.cpp)
+extern const Sprites SPRITES;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LEB128 variable length integers: 7 bits per byte, high bit set on every
+// byte but the last
+
+const size_t VARINT_MAX_BYTES = 10;
+
+inline void write_varint(uint8_t** cursor, uint64_t value)
+{
+	uint8_t* out = *cursor;
+	while (value >= 0x80)
+	{
+		*out++ = static_cast<uint8_t>(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = static_cast<uint8_t>(value);
+	*cursor = out;
+}
+
+// Returns false if the varint runs past end or is too long
+inline bool read_varint(const uint8_t** cursor, const uint8_t* end, uint64_t* value)
+{
+	const uint8_t* in = *cursor;
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (in == end) return false;
+
+		uint8_t byte = *in++;
+		result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+		{
+			*value = result;
+			*cursor = in;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+"""Generates GL.hpp and GL.cpp, the OpenGL loader of the game.
+
+Only the entry points and constants the sources actually use are emitted.
+Every entry point starts out pointing at a resolver that looks the real
+function up on its first call, so startup resolves nothing.
+
+    python generate_gl_loader.py path/to/gl.xml
+
+gl.xml is the Khronos registry (KhronosGroup/OpenGL-Registry, xml/gl.xml).
+The sources are the .cpp and .hpp files next to this script. Rerun it after
+calling a GL function or using a GL_ constant the loader does not have yet.
+"""
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+OUTPUTS = ("GL.hpp", "GL.cpp")
+
+# C definitions of the registry types, as khrplatform.h has them
+TYPES = {
+    "GLenum": "unsigned int",
+    "GLboolean": "unsigned char",
+    "GLbitfield": "unsigned int",
+    "GLbyte": "signed char",
+    "GLubyte": "unsigned char",
+    "GLshort": "short",
+    "GLushort": "unsigned short",
+    "GLhalf": "unsigned short",
+    "GLint": "int",
+    "GLuint": "unsigned int",
+    "GLsizei": "int",
+    "GLfloat": "float",
+    "GLclampf": "float",
+    "GLdouble": "double",
+    "GLclampd": "double",
+    "GLchar": "char",
+    "GLintptr": "ptrdiff_t",
+    "GLsizeiptr": "ptrdiff_t",
+    "GLint64": "int64_t",
+    "GLuint64": "uint64_t",
+    "GLsync": "struct __GLsync*",
+}
+
+
+def used_names(pattern):
+    names = set()
+    for file in sorted(os.listdir(ROOT)):
+        if not file.endswith((".cpp", ".hpp")) or file in OUTPUTS:
+            continue
+        with open(os.path.join(ROOT, file), encoding="utf-8") as source:
+            names.update(re.findall(pattern, source.read()))
+    return names
+
+
+def text(element):
+    return "".join(element.itertext()).strip()
+
+
+def load_registry(path):
+    registry = ElementTree.parse(path).getroot()
+
+    enums = {}
+    for enum in registry.iter("enum"):
+        name = enum.get("name")
+        api = enum.get("api")
+        if enum.get("value") is None or (api and api != "gl"):
+            continue
+        if name not in enums or api == "gl":
+            enums[name] = enum.get("value") + enum.get("type", "")
+
+    commands = {}
+    for command in registry.find("commands").iter("command"):
+        proto = command.find("proto")
+        name = proto.find("name").text
+        result = "".join(proto.itertext())
+        result = result[:result.rindex(name)].strip()
+        params = [(text(param), param.find("name").text) for param in command.findall("param")]
+        types = {ptype.text for ptype in command.iter("ptype")}
+        commands[name] = (result, params, types)
+
+    return enums, commands
+
+
+def type_name(declaration):
+    # "const GLchar *const*" -> "const GLchar* const*"
+    return re.sub(r"\s*\*\s*", "* ", declaration).strip()
+
+
+def generate(registry_path):
+    enums, commands = load_registry(registry_path)
+
+    used_commands = sorted(name for name in used_names(r"\b(gl[A-Z]\w*)\s*\(") if name in commands)
+    used_enums = sorted(name for name in used_names(r"\b(GL_[A-Z0-9_]+)\b") if name in enums)
+
+    used_types = set()
+    for name in used_commands:
+        used_types.update(commands[name][2])
+        used_types.update(re.findall(r"\bGL\w+", commands[name][0]))
+    unknown = used_types - set(TYPES)
+    if unknown:
+        sys.exit("No C definition for " + ", ".join(sorted(unknown)))
+
+    header = [
+        "#pragma once",
+        "",
+        "// Generated by generate_gl_loader.py from the Khronos gl.xml, do not edit.",
+        "// Holds only what the game uses. Entry points resolve on their first call",
+        "// through the function given to gl_init(), on the thread with the context.",
+        "",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "",
+        "#ifndef GLAPIENTRY",
+        "#if defined(_WIN32) && !defined(__CYGWIN__)",
+        "#define GLAPIENTRY __stdcall",
+        "#else",
+        "#define GLAPIENTRY",
+        "#endif",
+        "#endif",
+        "",
+    ]
+    header += ["typedef %s %s;" % (TYPES[name], name) for name in sorted(used_types)]
+    header += [""]
+    header += ["#define %s %s" % (name, enums[name]) for name in used_enums]
+    header += [
+        "",
+        "typedef void* (*GLLoadProc)(const char* name);",
+        "",
+        "// Sets where entry points come from, glfwGetProcAddress with GLFW. False",
+        "// if load finds no glGetString, as when no context is current.",
+        "bool gl_init(GLLoadProc load);",
+        "",
+        "// Looks an entry point up right away, null if the driver lacks it",
+        "void* gl_proc_address(const char* name);",
+        "",
+        "// Entry points resolved so far and the time spent resolving them",
+        "size_t gl_resolved_count();",
+        "int64_t gl_resolve_nanoseconds();",
+        "",
+    ]
+
+    source = [
+        "// Generated by generate_gl_loader.py from the Khronos gl.xml, do not edit.",
+        "",
+        '#include "GL.hpp"',
+        "",
+        "#include <chrono>",
+        "",
+        "static GLLoadProc gl_load;",
+        "static size_t gl_resolved;",
+        "static int64_t gl_resolve_time;",
+        "",
+        "bool gl_init(GLLoadProc load)",
+        "{",
+        "\tgl_load = load;",
+        '\treturn load("glGetString") != nullptr;',
+        "}",
+        "",
+        "void* gl_proc_address(const char* name)",
+        "{",
+        "\treturn gl_load(name);",
+        "}",
+        "",
+        "size_t gl_resolved_count()",
+        "{",
+        "\treturn gl_resolved;",
+        "}",
+        "",
+        "int64_t gl_resolve_nanoseconds()",
+        "{",
+        "\treturn gl_resolve_time;",
+        "}",
+        "",
+        "static void* gl_resolve(const char* name)",
+        "{",
+        "\tauto start = std::chrono::steady_clock::now();",
+        "\tvoid* proc = gl_load(name);",
+        "\tgl_resolve_time += (std::chrono::steady_clock::now() - start).count();",
+        "\t++gl_resolved;",
+        "\treturn proc;",
+        "}",
+    ]
+
+    for name in used_commands:
+        result, params, _ = commands[name]
+        result = type_name(result)
+        pointer = "PFN" + name.upper() + "PROC"
+        declarations = ", ".join(type_name(declaration[:declaration.rindex(param)]) + " " + param
+            for declaration, param in params) or "void"
+        arguments = ", ".join(param for _, param in params)
+
+        header += [
+            "typedef %s (GLAPIENTRY* %s)(%s);" % (result, pointer, declarations),
+            "extern %s gl_proc_%s;" % (pointer, name),
+            "#define %s gl_proc_%s" % (name, name),
+        ]
+        source += [
+            "",
+            "static %s GLAPIENTRY gl_resolve_%s(%s)" % (result, name, declarations),
+            "{",
+            '\tgl_proc_%s = reinterpret_cast<%s>(gl_resolve("%s"));' % (name, pointer, name),
+            "\t%sgl_proc_%s(%s);" % ("" if result == "void" else "return ", name, arguments),
+            "}",
+            "%s gl_proc_%s = gl_resolve_%s;" % (pointer, name, name),
+        ]
+
+    for file, lines in zip(OUTPUTS, (header, source)):
+        with open(os.path.join(ROOT, file), "w", encoding="utf-8", newline="\n") as out:
+            out.write("\n".join(lines) + "\n")
+
+    print("%d entry points and %d constants" % (len(used_commands), len(used_enums)))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    generate(sys.argv[1])